@@ -0,0 +1,94 @@
+// Broadphase of CollisionSystem::detect_collisions: the all-pairs loop it used to run against the spatial hash,
+// with 100, 1k and 10k colliders scattered over the window.
+#include "bench_common.hpp"
+#include "core/spatial_hash.hpp"
+#include "utils/rng.hpp"
+#include <cstdio>
+#include <unordered_set>
+
+struct Collider
+{
+    Entity entity;
+    vec2 center;
+    vec2 half_extents;
+};
+
+static std::vector<Collider> scatter(int count)
+{
+    Pcg32 rng;
+    rng.seed(count, 0);
+
+    std::vector<Collider> colliders;
+    for (int i = 0; i < count; i++)
+    {
+        const vec2 center = { rng.uniform(0.f, window_width_px), rng.uniform(0.f, window_height_px) };
+        colliders.push_back({ Entity::create(), center, vec2(rng.uniform(8.f, 24.f)) });
+    }
+    return colliders;
+}
+
+// Touching counts, like the spatial hash
+static bool overlaps(const Collider& a, const Collider& b)
+{
+    const vec2 distance = abs(a.center - b.center);
+    return distance.x <= a.half_extents.x + b.half_extents.x && distance.y <= a.half_extents.y + b.half_extents.y;
+}
+
+// The loop detect_collisions ran before the broadphase, down to its visited set
+static uint64_t all_pairs(const std::vector<Collider>& colliders)
+{
+    uint64_t pairs = 0;
+    std::unordered_set<Entity> visited;
+    for (const Collider& collider : colliders)
+    {
+        for (const Collider& other : colliders)
+        {
+            if (collider.entity == other.entity) continue;
+            if (visited.find(other.entity) != visited.end()) continue;
+            if (overlaps(collider, other)) pairs++;
+        }
+        visited.insert(collider.entity);
+    }
+    return pairs;
+}
+
+static uint64_t spatial_hash(SpatialHash& hash, const std::vector<Collider>& colliders, std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    hash.clear();
+    pairs.clear();
+    for (const Collider& collider : colliders)
+    {
+        hash.insert(collider.entity, collider.center, collider.half_extents, 1, 1);
+    }
+    hash.find_pairs(pairs);
+    return pairs.size();
+}
+
+int main()
+{
+    const int counts[] = { 100, 1000, 10000 };
+    for (int count : counts)
+    {
+        const std::vector<Collider> colliders = scatter(count);
+        SpatialHash hash;
+        std::vector<std::pair<Entity, Entity>> pairs;
+
+        const uint64_t expected = all_pairs(colliders);
+        const uint64_t found = spatial_hash(hash, colliders, pairs);
+        printf("%d colliders, %llu overlapping pairs\n", count, (unsigned long long)expected);
+        if (found != expected)
+        {
+            fprintf(stderr, "spatial hash found %llu pairs, all pairs found %llu\n", (unsigned long long)found, (unsigned long long)expected);
+            return 1;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "  all pairs    n=%d", count);
+        benchmark(name, count <= 1000 ? 50 : 3, [&] { return all_pairs(colliders); });
+        snprintf(name, sizeof(name), "  spatial hash n=%d", count);
+        benchmark(name, 200, [&] { return spatial_hash(hash, colliders, pairs); });
+
+        for (const Collider& collider : colliders) Entity::release(collider.entity);
+    }
+    return 0;
+}
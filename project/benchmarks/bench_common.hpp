@@ -0,0 +1,36 @@
+#pragma once
+#include "utils/profiler.hpp"
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+/*
+    Shared timing of the microbenchmarks in benchmarks/.
+    Configure with -DCMAKE_BUILD_TYPE=Release, the numbers of an unoptimized build say little.
+*/
+
+// Time 'runs' calls of work and print their distribution, setup runs before each call outside of the timing.
+// Work returns a checksum of what it computed, which is kept so the optimizer cannot drop it.
+// One untimed run first lets buffers reach their steady state capacity.
+template <typename Setup, typename Work>
+void benchmark(const char* name, int runs, Setup&& setup, Work&& work)
+{
+    setup();
+    volatile uint64_t sink = work();
+
+    FrameTimes times;
+    for (int run = 0; run < runs; run++)
+    {
+        setup();
+        const auto start = std::chrono::high_resolution_clock::now();
+        sink = sink + work();
+        times.add(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+    }
+    times.report(stdout, name);
+}
+
+template <typename Work>
+void benchmark(const char* name, int runs, Work&& work)
+{
+    benchmark(name, runs, [] {}, std::forward<Work>(work));
+}
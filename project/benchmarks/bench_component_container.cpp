@@ -0,0 +1,141 @@
+// has/get/insert/remove throughput of ComponentContainer: the unordered_map entity index it used to have against
+// the paged sparse set, with 10k entities holding the component, 10k that do not, and lookups in random order.
+#include "bench_common.hpp"
+#include "entities/ecs.hpp"
+#include "utils/rng.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <glm/vec2.hpp>
+#include <unordered_map>
+
+using glm::vec2;
+
+// About the size of the hot part of Motion
+struct Payload
+{
+    vec2 position;
+    vec2 velocity;
+    vec2 scale;
+    float angle;
+};
+
+// ComponentContainer before the sparse set, down to its entity -> index hash map
+template <typename Component>
+class HashedContainer
+{
+    std::unordered_map<unsigned int, unsigned int> map_entity_componentID;
+
+public:
+    std::vector<Component> components;
+    std::vector<Entity> entities;
+
+    Component& insert(Entity e, Component c)
+    {
+        map_entity_componentID[e] = (unsigned int)components.size();
+        components.push_back(std::move(c));
+        entities.push_back(e);
+        return components.back();
+    }
+
+    Component& get(Entity e)
+    {
+        return components[map_entity_componentID[e]];
+    }
+
+    bool has(Entity entity)
+    {
+        return map_entity_componentID.count(entity) > 0;
+    }
+
+    void remove(Entity e)
+    {
+        if (has(e))
+        {
+            int cID = map_entity_componentID[e];
+            components[cID] = std::move(components.back());
+            entities[cID] = entities.back();
+            map_entity_componentID[entities.back()] = cID;
+            map_entity_componentID.erase(e);
+            components.pop_back();
+            entities.pop_back();
+        }
+    }
+
+    void clear()
+    {
+        map_entity_componentID.clear();
+        components.clear();
+        entities.clear();
+    }
+
+    size_t size() const { return components.size(); }
+};
+
+template <typename Container>
+static void run(const char* label, Container& container, const std::vector<Entity>& present, const std::vector<Entity>& absent)
+{
+    const int runs = 200;
+    char name[64];
+
+    // Systems look entities up in whatever order they meet them, not in insertion order
+    std::vector<Entity> shuffled = present;
+    Pcg32 rng;
+    rng.seed(1, 0);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+    auto fill = [&] {
+        container.clear();
+        for (const Entity& e : present) container.insert(e, Payload{ vec2((float)e.index()), vec2(0.f), vec2(1.f), 0.f });
+    };
+
+    snprintf(name, sizeof(name), "  %-11s insert", label);
+    benchmark(name, runs, [&] { container.clear(); }, [&] {
+        for (const Entity& e : present) container.insert(e, Payload{ vec2((float)e.index()), vec2(0.f), vec2(1.f), 0.f });
+        return (uint64_t)container.size();
+    });
+
+    fill();
+    snprintf(name, sizeof(name), "  %-11s has   ", label);
+    benchmark(name, runs, [&] {
+        uint64_t hits = 0;
+        for (size_t i = 0; i < shuffled.size(); i++) hits += container.has(shuffled[i]) + container.has(absent[i]);
+        return hits;
+    });
+
+    snprintf(name, sizeof(name), "  %-11s get   ", label);
+    benchmark(name, runs, [&] {
+        uint64_t sum = 0;
+        for (const Entity& e : shuffled) sum += (uint64_t)container.get(e).position.x;
+        return sum;
+    });
+
+    snprintf(name, sizeof(name), "  %-11s remove", label);
+    benchmark(name, runs, fill, [&] {
+        for (const Entity& e : shuffled) container.remove(e);
+        return (uint64_t)container.size();
+    });
+}
+
+int main()
+{
+    const int ENTITIES = 10000;
+
+    // Entities with and without the component interleave, as they do in the registry
+    std::vector<Entity> present, absent;
+    for (int i = 0; i < ENTITIES; i++)
+    {
+        present.push_back(Entity::create());
+        absent.push_back(Entity::create());
+    }
+    printf("%d entities with the component, %d without\n", ENTITIES, ENTITIES);
+
+    HashedContainer<Payload> hashed;
+    run("hash map", hashed, present, absent);
+
+    // Bound to a signature table like every container of the registry
+    ComponentSignatures signatures;
+    ComponentContainer<Payload> sparse;
+    sparse.bind_signatures(&signatures, 1);
+    run("sparse set", sparse, present, absent);
+    return 0;
+}
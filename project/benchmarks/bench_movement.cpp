@@ -0,0 +1,111 @@
+// Per-tick cost of moving 5k walkers: the loop handleMovements used to run, with its hash lookups of the player,
+// enemy and debuff status of every entity, against the loop it runs now over the walkers of a view.
+#include "bench_common.hpp"
+#include "core/occupancy_grid.hpp"
+#include "entities/general_components.hpp"
+#include "utils/rng.hpp"
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+
+static const float TICK_MS = 1000.f / 60.f;
+
+static uint64_t checksum(const std::vector<Motion>& motions)
+{
+    uint64_t sum = 0;
+    for (const Motion& motion : motions) sum += (uint64_t)(motion.position.x + motion.position.y);
+    return sum;
+}
+
+// Registry state of the old loop, every lookup a hash probe
+struct HashedRegistry
+{
+    std::vector<unsigned int> entities;
+    std::unordered_map<unsigned int, unsigned int> motion_index;
+    std::unordered_set<unsigned int> players;
+    std::unordered_set<unsigned int> enemies;
+    std::unordered_map<unsigned int, float> slow_debuffs;
+};
+
+static uint64_t hashed(HashedRegistry& registry, std::vector<Motion>& motions)
+{
+    for (unsigned int entity : registry.entities)
+    {
+        Motion& motion = motions[registry.motion_index[entity]];
+
+        if (registry.players.count(entity) > 0 || registry.enemies.count(entity) > 0)
+        {
+            float x_offset = motion.collider.x * motion.scale.x;
+            float y_offset = motion.collider.y * motion.scale.y;
+
+            float slowFactor = 1;
+            auto debuff = registry.slow_debuffs.find(entity);
+            if (debuff != registry.slow_debuffs.end()) {
+                slowFactor = debuff->second;
+            }
+
+            motion.position = glm::clamp(motion.position + motion.velocity * slowFactor * TICK_MS, { x_offset, y_offset }, { window_width_px - x_offset, window_height_px - y_offset });
+        }
+    }
+    return checksum(motions);
+}
+
+// Velocity, slow factor, window clamp and terrain applied to one Motion at a time, as handleMovements does now
+static uint64_t view_loop(std::vector<Motion>& motions, const std::vector<float>& slow, const OccupancyGrid& terrain)
+{
+    for (size_t i = 0; i < motions.size(); i++)
+    {
+        Motion& motion = motions[i];
+        float x_offset = motion.collider.x * motion.scale.x;
+        float y_offset = motion.collider.y * motion.scale.y;
+        const vec2 half_extents = glm::abs(vec2(x_offset, y_offset)) / 2.f;
+        const vec2 moved = glm::clamp(motion.position + motion.velocity * slow[i] * TICK_MS, { x_offset, y_offset }, { window_width_px - x_offset, window_height_px - y_offset });
+        motion.position = terrain.resolveMovement(motion.position, moved, half_extents);
+    }
+    return checksum(motions);
+}
+
+int main()
+{
+    const int MOVERS = 5000;
+
+    Pcg32 rng;
+    rng.seed(MOVERS, 0);
+    std::vector<Motion> motions(MOVERS);
+    std::vector<float> slow(MOVERS);
+    for (int i = 0; i < MOVERS; i++)
+    {
+        motions[i].position = { rng.uniform(0.f, window_width_px), rng.uniform(0.f, window_height_px) };
+        motions[i].velocity = { rng.uniform(-0.2f, 0.2f), rng.uniform(-0.2f, 0.2f) };
+        // A quarter of them are slowed, as by water spells
+        slow[i] = rng.uniformInt(0, 3) == 0 ? 0.5f : 1.f;
+    }
+
+    printf("%d movers\n", MOVERS);
+
+    HashedRegistry registry;
+    for (unsigned int i = 0; i < MOVERS; i++)
+    {
+        const unsigned int entity = i + 1;
+        registry.entities.push_back(entity);
+        registry.motion_index[entity] = i;
+        if (i == 0) registry.players.insert(entity);
+        else registry.enemies.insert(entity);
+        if (slow[i] != 1.f) registry.slow_debuffs[entity] = slow[i];
+    }
+    std::vector<Motion> hashed_motions = motions;
+    benchmark("  hash lookups", 1000, [&] { return hashed(registry, hashed_motions); });
+
+    // No tile blocks movement yet, the terrain test returns early like in the game
+    OccupancyGrid terrain;
+    std::vector<Motion> view_motions = motions;
+    benchmark("  view loop   ", 1000, [&] { return view_loop(view_motions, slow, terrain); });
+
+    // Both loops do the same arithmetic, they must stay in step
+    if (checksum(hashed_motions) != checksum(view_motions))
+    {
+        fprintf(stderr, "view loop positions differ from the hashed ones\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Broadphase under the "swarm the player" workload: enemies start scattered over the window and close in on the
+// player in the middle over ten seconds of ticks, ending packed around it. Both broadphases see the same ticks,
+// the spatial hash rebuilt every tick and sweep-and-prune re-sorting its endpoints from the previous one.
+#include "bench_common.hpp"
+#include "core/spatial_hash.hpp"
+#include "core/sweep_and_prune.hpp"
+#include "utils/rng.hpp"
+#include <cstdio>
+#include <glm/geometric.hpp>
+
+static const float TICK_MS = 1000.f / 60.f;
+static const int TICKS = 600;
+
+class Swarm
+{
+public:
+    explicit Swarm(int count)
+    {
+        Pcg32 rng;
+        rng.seed(count, 0);
+        for (int i = 0; i < count; i++)
+        {
+            Enemy enemy;
+            enemy.entity = Entity::create();
+            enemy.center = { rng.uniform(0.f, window_width_px), rng.uniform(0.f, window_height_px) };
+            enemy.half_extents = vec2(rng.uniform(10.f, 20.f));
+            enemy.speed = rng.uniform(0.05f, 0.15f);
+            // Melee enemies press up against the player, ranged ones hold back a little
+            enemy.stop_distance = rng.uniform(20.f, 160.f);
+            enemies.push_back(enemy);
+        }
+    }
+
+    ~Swarm()
+    {
+        for (const Enemy& enemy : enemies) Entity::release(enemy.entity);
+    }
+
+    void step()
+    {
+        const vec2 player = { window_width_px / 2.f, window_height_px / 2.f };
+        for (Enemy& enemy : enemies)
+        {
+            const vec2 offset = player - enemy.center;
+            const float distance = glm::length(offset);
+            if (distance <= enemy.stop_distance) continue;
+            enemy.center += offset / distance * std::min(enemy.speed * TICK_MS, distance - enemy.stop_distance);
+        }
+    }
+
+    uint64_t find_pairs(Broadphase& broadphase)
+    {
+        broadphase.clear();
+        pairs.clear();
+        for (const Enemy& enemy : enemies)
+        {
+            broadphase.insert(enemy.entity, enemy.center, enemy.half_extents, 1, 1);
+        }
+        broadphase.find_pairs(pairs);
+        return pairs.size();
+    }
+
+private:
+    struct Enemy
+    {
+        Entity entity;
+        vec2 center;
+        vec2 half_extents;
+        float speed;
+        float stop_distance;
+    };
+
+    std::vector<Enemy> enemies;
+    std::vector<std::pair<Entity, Entity>> pairs;
+};
+
+// Runs the swarm from its start and returns the pairs found over every tick
+static uint64_t run(const char* name, int count, Broadphase& broadphase)
+{
+    Swarm swarm(count);
+    uint64_t total_pairs = 0;
+    benchmark(name, TICKS, [&] { swarm.step(); }, [&] {
+        const uint64_t pairs = swarm.find_pairs(broadphase);
+        total_pairs += pairs;
+        return pairs;
+    });
+    return total_pairs;
+}
+
+int main()
+{
+    const int counts[] = { 500, 2000 };
+    for (int count : counts)
+    {
+        printf("%d enemies, %d ticks\n", count, TICKS);
+
+        char name[64];
+        SpatialHash grid;
+        snprintf(name, sizeof(name), "  grid            n=%d", count);
+        const uint64_t grid_pairs = run(name, count, grid);
+
+        SweepAndPrune sweep_and_prune;
+        snprintf(name, sizeof(name), "  sweep and prune n=%d", count);
+        const uint64_t sap_pairs = run(name, count, sweep_and_prune);
+
+        if (grid_pairs != sap_pairs)
+        {
+            fprintf(stderr, "grid found %llu pairs, sweep and prune %llu\n", (unsigned long long)grid_pairs, (unsigned long long)sap_pairs);
+            return 1;
+        }
+        printf("  %.1f overlapping pairs per tick\n", (double)grid_pairs / (TICKS + 1));
+    }
+    return 0;
+}
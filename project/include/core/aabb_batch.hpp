@@ -0,0 +1,26 @@
+#pragma once
+#include "core/common.hpp"
+#include <vector>
+
+/*
+    Axis aligned boxes packed as structure-of-arrays, so one box can be tested against
+    a whole candidate list with SIMD (8 boxes per step with AVX2, 4 with SSE2, scalar otherwise).
+    Boxes are stored as min/max bounds rather than center/half extents, so the batch test gives
+    exactly the same answer as the scalar bound comparisons it replaces.
+*/
+class AabbBatch
+{
+public:
+    void clear();
+    void push_back(const vec2& min, const vec2& max);
+    // Move the last box into slot i and drop the last slot
+    void swap_pop(size_t i);
+
+    size_t size() const { return min_x.size(); }
+
+    // hits[i] = 1 if box i overlaps [min, max] (touching counts), 0 otherwise. Returns the number of hits.
+    size_t overlap_mask(const vec2& min, const vec2& max, std::vector<unsigned char>& hits) const;
+
+private:
+    std::vector<float> min_x, min_y, max_x, max_y;
+};
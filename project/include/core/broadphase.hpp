@@ -0,0 +1,27 @@
+#pragma once
+#include "core/common.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/*
+    Common interface of the collision broadphases, see BroadphaseType.
+    Every tick the broadphase is cleared, every live collider is submitted with insert(),
+    then find_pairs() reports each pair of overlapping AABBs whose layers interact exactly once.
+*/
+class Broadphase
+{
+public:
+    virtual ~Broadphase() = default;
+
+    virtual void clear() = 0;
+    virtual void insert(const Entity& entity, const vec2& center, const vec2& half_extents, uint32_t layer, uint32_t mask) = 0;
+    virtual void find_pairs(std::vector<std::pair<Entity, Entity>>& pairs) = 0;
+
+protected:
+    // See CollisionLayer
+    static bool layers_interact(uint32_t layer, uint32_t mask, uint32_t other_layer, uint32_t other_mask)
+    {
+        return (mask & other_layer) != 0 || (other_mask & layer) != 0;
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include "core/common.hpp"
+#include "entities/general_components.hpp"
+#include <unordered_map>
+#include <vector>
+
+// Triangles of a collider mesh in local space, copied once from the mesh when it is first used
+struct ColliderShape
+{
+    enum { MAX_TRIANGLES = 16 };
+
+    int triangle_count = 0;
+    vec2 vertices[MAX_TRIANGLES][3];
+    vec2 normals[MAX_TRIANGLES][3]; // edge normals, not normalized
+};
+
+// Collider shape placed at an entity, vertices and normals in world space
+struct TransformedCollider
+{
+    int triangle_count = 0;
+    vec2 vertices[ColliderShape::MAX_TRIANGLES][3];
+    vec2 normals[ColliderShape::MAX_TRIANGLES][3];
+    vec2 min;
+    vec2 max;
+};
+
+/*
+    Mesh colliders for the SAT narrowphase.
+    Shapes are extracted from the meshes once, and each entity's shape is transformed at most once per tick,
+    so repeated hit checks against the same entity (e.g. the player under heavy fire) only read cached data.
+*/
+class ColliderCache
+{
+public:
+    void load(const AssetId& name, const Mesh& mesh);
+    bool has(const AssetId& name) const;
+
+    // Starts a new tick, all transformed colliders become stale
+    void next_tick();
+    // Transforms the entity's collider if it was not yet this tick, main thread only
+    const TransformedCollider& get(const Entity& entity, const AssetId& name, const Motion& motion);
+    // Only reads, so worker threads may call it once get() transformed the entity's collider this tick
+    const TransformedCollider& lookup(const Entity& entity) const;
+
+private:
+    struct Entry
+    {
+        Entity entity;
+        unsigned int tick; // tick the collider was transformed in
+        TransformedCollider collider;
+    };
+
+    unsigned int tick = 1;
+    TransformedCollider empty; // lookup() of an entity that was never transformed
+    std::unordered_map<AssetId, ColliderShape> shapes;
+    std::vector<Entry> entries; // only a few entities carry mesh colliders
+};
+
+// Separating axis test of a world space triangle against an axis aligned box
+bool triangle_overlaps_box(const vec2 (&triangle)[3], const vec2 (&normals)[3], const vec2& box_min, const vec2& box_max);
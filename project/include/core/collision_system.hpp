@@ -3,14 +3,30 @@
 #include "core/common.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include "graphics/particle_system.hpp"
+#include "core/broadphase.hpp"
+#include "core/collider_cache.hpp"
+#include "utils/thread_pool.hpp"
+#include <memory>
+#include <unordered_set>
 
 
 
+// Interactions between collision pairs, each pair is classified into one before being resolved
+enum class CollisionCategory
+{
+    PROJECTILE_PLAYER,
+    PROJECTILE_ENEMY,
+    ENEMY_PLAYER,
+    INTERACTABLE_PLAYER,
+    COUNT
+};
+
 class CollisionSystem
 {
 
 public:
     explicit CollisionSystem(IRenderSystem* renderer);
+    ~CollisionSystem();
     void init();
     void detect_collisions();
     void resolve_collisions();
@@ -19,8 +35,53 @@ public:
     void pickupSpell(Entity target, SpellType type);
 
 private:
+    using EntityPair = std::pair<Entity, Entity>;
+
+    // Effects gathered while resolving, applied once every category was handled
+    struct ResolutionContext
+    {
+        std::unordered_map<SpellType, int, SpellTypeHash> cycle_progress;
+        std::unordered_map<PostResolution, std::pair<Entity, std::vector<Entity>>> post_resolutions;
+        std::unordered_set<Entity> to_deactivate;
+        std::unordered_set<Entity> to_delete;
+    };
+
+    // Pair of a category, ordered as (category's first type, second type), and the narrowphase result
+    struct Contact
+    {
+        EntityPair pair;
+        bool touching;
+    };
+
+    // Narrowphase of a category. Runs on worker threads, so it may only read the registry.
+    using NarrowphaseTest = bool (CollisionSystem::*)(const EntityPair& pair);
+    // Applies the effects of every contact of one category, in order, on the main thread
+    using CategoryHandler = void (CollisionSystem::*)(const std::vector<Contact>& contacts, ResolutionContext& context);
+
     IRenderSystem* renderer;
     ParticleSystem particleSystem;
+    std::unique_ptr<Broadphase> broadphase;
+    std::vector<std::pair<Entity, Entity>> candidate_pairs;
+    ColliderCache collider_cache;
+    CategoryHandler handlers[(int)CollisionCategory::COUNT] = {};
+    NarrowphaseTest narrowphase_tests[(int)CollisionCategory::COUNT] = {};
+    std::vector<Contact> buckets[(int)CollisionCategory::COUNT];
+    ThreadPool workers;
+    std::vector<Entity> nearby; // spatial query results
+
+    void register_handler(CollisionCategory category, CategoryHandler handler, NarrowphaseTest test = nullptr);
+    bool classify(const Entity& entity, const Entity& other_entity, CollisionCategory& category, EntityPair& ordered) const;
+    void prepare_mesh_colliders();
+    void run_narrowphase(std::vector<Contact>& contacts, NarrowphaseTest test);
+
+    void apply_wind_pull();
+    bool mesh_contact(const EntityPair& pair);
+    bool pickup_contact(const EntityPair& pair);
+    void resolve_projectile_player(const std::vector<Contact>& contacts, ResolutionContext& context);
+    void resolve_projectile_enemy(const std::vector<Contact>& contacts, ResolutionContext& context);
+    void resolve_enemy_player(const std::vector<Contact>& contacts, ResolutionContext& context);
+    void resolve_interactable_player(const std::vector<Contact>& contacts, ResolutionContext& context);
+
     bool is_mesh_colliding(const Entity& player, const Entity& other_entity);
     bool isWaterProtected(const Entity& player, const Entity& attacker);
     void resolve_post_effects(const std::unordered_map<PostResolution, std::pair<Entity, std::vector<Entity>>> resolutions);
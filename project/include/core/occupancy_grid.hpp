@@ -0,0 +1,57 @@
+#pragma once
+#include "core/common.hpp"
+#include <cstdint>
+#include <vector>
+
+/*
+    Static terrain that blocks movement, baked once per game from the tile grid (see TileGenerator::bakeOccupancy).
+    One bit per tile, on the same isometric lattice the tiles are drawn on: cell (col, row) is the parallelogram
+    spanned by col_axis and row_axis around the centre of that tile. Testing a mover is a handful of bit reads
+    instead of a collision pair. Cells outside the grid are free, the window clamp keeps movers inside it.
+*/
+class OccupancyGrid
+{
+public:
+    // Size the grid to cols x rows tiles, every cell free. Tile (col, row) is centred on origin + col * col_axis + row * row_axis.
+    void reset(const vec2& origin, const vec2& col_axis, const vec2& row_axis, int cols, int rows);
+
+    void setBlocked(int col, int row, bool blocked = true);
+    void setBlocked(const vec2& position, bool blocked = true);
+
+    bool isBlocked(int col, int row) const;
+    bool isBlocked(const vec2& position) const;
+    // Whether any blocked cell overlaps [min, max]
+    bool isBoxBlocked(const vec2& min, const vec2& max) const;
+    // Whether the segment crosses no blocked cell
+    bool isSegmentClear(const vec2& from, const vec2& to) const;
+
+    // Move a box of half_extents from 'from' towards 'to', sliding along blocked cells.
+    // Long moves are stepped at most half a cell at a time so they cannot tunnel through a wall.
+    vec2 resolveMovement(const vec2& from, const vec2& to, const vec2& half_extents) const;
+    // Direction closest to 'direction' whose next 'lookahead' units are clear, for AI steering
+    vec2 steerAround(const vec2& position, const vec2& direction, float lookahead) const;
+
+    bool empty() const { return blocked_count == 0; }
+
+private:
+    // Corner of cell (0, 0), cells are whole units in grid space
+    vec2 origin = vec2(0.f);
+    vec2 col_axis = { 1.f, 0.f };
+    vec2 row_axis = { 0.f, 1.f };
+    // Rows of the inverse of [col_axis row_axis], world offsets to grid space
+    vec2 to_col = { 1.f, 0.f };
+    vec2 to_row = { 0.f, 1.f };
+    // World bounds of a cell relative to its corner
+    vec2 cell_min = vec2(0.f);
+    vec2 cell_max = vec2(1.f);
+    // Distance between the closest opposite edges of a cell
+    float cell_width = 1.f;
+    int cols = 0;
+    int rows = 0;
+    unsigned int blocked_count = 0;
+    std::vector<uint64_t> bits;
+
+    vec2 to_grid(const vec2& position) const;
+};
+
+extern OccupancyGrid occupancy_grid;
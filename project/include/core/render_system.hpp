@@ -29,7 +29,10 @@ public:
     void setUpView() const override;
     void initializeCamera() override;
     GLFWwindow* getGLWindow() const override;
-    void drawFrame(float elapsed_ms) override;
+    bool shouldClose() const override;
+    void getFramebufferSize(int& width, int& height) const override;
+    void buildTileLayer(TileGenerator& tile_generator) override;
+    void drawFrame(float elapsed_ms, float alpha) override;
 
     void drawText(const std::string& text,
         const std::string& fontName,
@@ -104,6 +107,7 @@ private:
         RenderIndex(size_t i, float y) : index(i), render_y(y) {}
     };
 
+    vec2 interpolatedPosition(const Entity& entity) const;
     void updateCameraPosition(float x, float y);
     void drawBackgroundObjects();
     void drawHealthBars();
@@ -117,6 +121,7 @@ private:
     void drawInteractions();
 
     std::vector<RenderIndex> sorted_indices;
+    float frame_alpha = 1.f;
     Entity screen_state_entity;
     GLFWwindow* window = nullptr;
     IAssetManager* asset_manager = nullptr;
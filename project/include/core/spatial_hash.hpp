@@ -0,0 +1,62 @@
+#pragma once
+#include "core/aabb_batch.hpp"
+#include "core/broadphase.hpp"
+#include "core/common.hpp"
+#include <utility>
+#include <vector>
+
+/*
+    Uniform grid broadphase over world space.
+    Every AABB is bucketed into the cells it covers, so only entities sharing a cell are
+    tested against each other. The grid is rebuilt from scratch every tick; buckets keep
+    their memory between ticks so steady-state rebuilds do not allocate.
+*/
+class SpatialHash : public Broadphase
+{
+public:
+    explicit SpatialHash(float cell_size = DEFAULT_CELL_SIZE);
+
+    void clear() override;
+    void insert(const Entity& entity, const vec2& center, const vec2& half_extents, uint32_t layer, uint32_t mask) override;
+
+    // Appends every overlapping (AABB) pair exactly once
+    void find_pairs(std::vector<std::pair<Entity, Entity>>& pairs) override;
+
+    // Region queries, build() must run after the last insert (find_pairs builds on its own)
+    void build();
+    // Appends the id of every proxy overlapping [min, max] (touching counts) once
+    void query(const vec2& min, const vec2& max, std::vector<unsigned int>& proxy_ids) const;
+
+    void set_cell_size(float size);
+    float get_cell_size() const { return cell_size; }
+    size_t size() const { return proxies.size(); }
+
+    static constexpr float DEFAULT_CELL_SIZE = 64.f;
+
+    struct Proxy
+    {
+        Entity entity;
+        vec2 min;
+        vec2 max;
+        uint32_t layer;
+        uint32_t mask;
+        ivec2 min_cell;
+        ivec2 max_cell;
+    };
+
+    const Proxy& proxy(unsigned int id) const { return proxies[id]; }
+
+private:
+
+    float cell_size;
+    float inv_cell_size;
+    std::vector<Proxy> proxies;
+    std::vector<std::vector<unsigned int>> buckets; // proxy indices per hashed cell
+    std::vector<unsigned int> used_buckets;         // buckets to reset on the next rebuild
+    AabbBatch candidate_boxes;                      // candidates of one cell, tested in one batch
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned char> hits;
+
+    int to_cell(float value) const;
+    size_t bucket_of(int cell_x, int cell_y) const;
+};
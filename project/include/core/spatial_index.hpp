@@ -0,0 +1,45 @@
+#pragma once
+#include "core/common.hpp"
+#include "core/spatial_hash.hpp"
+#include "entities/ecs_registry.hpp"
+#include <vector>
+
+/*
+    Neighbour queries over the entities taking part in collisions (those with a CollisionLayer).
+    Queries only visit the hashed cells around the queried region. With the grid broadphase the index reads the
+    grid the broadphase built for this tick, swept colliders then cover their whole movement of the tick;
+    otherwise update() builds a grid of its own from every collider's Motion. Positions are those of the last update().
+    Results are filtered to entities holding every component of 'required', see ECSRegistry::component_bit.
+    Not thread safe, queries share scratch buffers.
+*/
+class SpatialIndex
+{
+public:
+    explicit SpatialIndex(float cell_size = BROADPHASE_CELL_SIZE);
+
+    // Query the grid of this broadphase instead of building one, nullptr to index on our own again
+    void share_broadphase(SpatialHash* broadphase);
+    // Re-index every live collider, call once the broadphase found the pairs of the tick
+    void update(ECSRegistry& registry);
+    void clear();
+
+    // Entities whose box overlaps [min, max]
+    void queryAABB(const vec2& min, const vec2& max, std::vector<Entity>& out, ComponentMask required = 0);
+    // Entities whose box is within radius of center
+    void queryRadius(const vec2& center, float radius, std::vector<Entity>& out, ComponentMask required = 0);
+    // Up to k entities closest to center (by box) within max_distance, closest first
+    void nearestK(const vec2& center, unsigned int k, std::vector<Entity>& out, ComponentMask required = 0, float max_distance = INFINITY);
+
+private:
+    SpatialHash own_grid;
+    SpatialHash* grid; // own_grid or the shared broadphase
+    vec2 bounds_min = vec2(0.f);
+    vec2 bounds_max = vec2(0.f);
+    std::vector<unsigned int> proxy_ids;
+    std::vector<std::pair<float, Entity>> by_distance;
+
+    bool accepts(const Entity& entity, ComponentMask required) const;
+    float distance_squared(const vec2& point, unsigned int proxy_id) const;
+};
+
+extern SpatialIndex spatial_index;
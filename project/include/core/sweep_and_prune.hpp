@@ -0,0 +1,58 @@
+#pragma once
+#include "core/aabb_batch.hpp"
+#include "core/broadphase.hpp"
+#include "core/common.hpp"
+#include <utility>
+#include <vector>
+
+/*
+    Persistent sweep-and-prune broadphase along the x axis.
+    Interval endpoints stay sorted across ticks and are re-sorted with an insertion sort, which is close to
+    linear since colliders only move a little each tick. A sweep over the sorted endpoints then reports the
+    pairs whose x intervals overlap and whose y intervals overlap too. Unlike a uniform grid it is not
+    affected by many enemies crowding into the same cells around the player.
+*/
+class SweepAndPrune : public Broadphase
+{
+public:
+    void clear() override;
+    void insert(const Entity& entity, const vec2& center, const vec2& half_extents, uint32_t layer, uint32_t mask) override;
+    void find_pairs(std::vector<std::pair<Entity, Entity>>& pairs) override;
+
+    size_t size() const { return proxies.size() - free_proxies.size(); }
+
+private:
+    static const unsigned int INVALID_PROXY = 0xFFFFFFFF;
+
+    struct Proxy
+    {
+        Entity entity;
+        vec2 min;
+        vec2 max;
+        uint32_t layer;
+        uint32_t mask;
+        unsigned int tick;         // last tick the proxy was submitted, older proxies are dropped
+        unsigned int active_slot;  // position in the active list during the sweep
+        bool in_use;
+    };
+
+    struct Endpoint
+    {
+        float value;
+        unsigned int proxy;
+        bool is_min;
+    };
+
+    unsigned int tick = 0;
+    std::vector<Proxy> proxies;
+    std::vector<unsigned int> free_proxies;
+    std::vector<unsigned int> proxy_of_entity; // Entity::index() -> proxy
+    std::vector<Endpoint> endpoints;           // sorted along x
+    std::vector<unsigned int> active;
+    AabbBatch active_boxes;                    // bounds of 'active', same order
+    std::vector<unsigned char> hits;
+
+    static bool endpoint_less(const Endpoint& a, const Endpoint& b);
+    void remove_stale_proxies();
+    void sort_endpoints();
+};
@@ -52,7 +52,6 @@ private:
    void spawn_darklord_squad();
 
    // Mix_Music* background_music;
-   GLFWwindow* window{};
    IRenderSystem* renderer;
    CollisionSystem* collision_system;
    // IInputHandler* input_handler;
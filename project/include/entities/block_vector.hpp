@@ -0,0 +1,188 @@
+#pragma once
+
+#include <assert.h>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Largest power of two count of elements that fits a ~16KB block (at least one)
+constexpr size_t block_elements_for(size_t element_size)
+{
+	size_t count = 1;
+	while (count * 2 * element_size <= 16384)
+		count *= 2;
+	return count;
+}
+
+// Sequence stored in fixed-size blocks that are never moved once allocated.
+// Appending never relocates existing elements, so references stay valid until the element itself is
+// removed, and growth never copies. Elements inside a block are contiguous for cache-friendly iteration.
+template <typename T, size_t BlockElements = block_elements_for(sizeof(T))>
+class BlockVector
+{
+	static_assert((BlockElements & (BlockElements - 1)) == 0, "Block size must be a power of two");
+
+	std::vector<T*> blocks; // allocated blocks, kept on clear() for re-use
+	size_t count = 0;
+
+	static T* allocate_block()
+	{
+		return static_cast<T*>(::operator new(sizeof(T) * BlockElements));
+	}
+
+	T* slot(size_t i) const
+	{
+		return blocks[i / BlockElements] + (i % BlockElements);
+	}
+
+	T* next_slot()
+	{
+		if (count == blocks.size() * BlockElements)
+			blocks.push_back(allocate_block());
+		return slot(count);
+	}
+
+public:
+	template <bool IsConst>
+	class Iterator
+	{
+		using Owner = typename std::conditional<IsConst, const BlockVector, BlockVector>::type;
+		Owner* owner;
+		size_t i;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = typename std::conditional<IsConst, const T*, T*>::type;
+		using reference = typename std::conditional<IsConst, const T&, T&>::type;
+
+		Iterator(Owner* owner, size_t i) : owner(owner), i(i) {}
+
+		reference operator*() const { return (*owner)[i]; }
+		pointer operator->() const { return &(*owner)[i]; }
+		reference operator[](difference_type n) const { return (*owner)[i + n]; }
+		Iterator& operator++() { i++; return *this; }
+		Iterator operator++(int) { Iterator it = *this; i++; return it; }
+		Iterator& operator--() { i--; return *this; }
+		Iterator operator--(int) { Iterator it = *this; i--; return it; }
+		Iterator& operator+=(difference_type n) { i += n; return *this; }
+		Iterator& operator-=(difference_type n) { i -= n; return *this; }
+		Iterator operator+(difference_type n) const { return Iterator(owner, i + n); }
+		Iterator operator-(difference_type n) const { return Iterator(owner, i - n); }
+		difference_type operator-(const Iterator& other) const { return (difference_type)i - (difference_type)other.i; }
+		bool operator==(const Iterator& other) const { return i == other.i; }
+		bool operator!=(const Iterator& other) const { return i != other.i; }
+		bool operator<(const Iterator& other) const { return i < other.i; }
+	};
+
+	using value_type = T;
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	static const size_t block_capacity = BlockElements;
+
+	BlockVector() = default;
+	BlockVector(const BlockVector&) = delete;
+	BlockVector& operator=(const BlockVector&) = delete;
+
+	BlockVector(BlockVector&& other) noexcept
+		: blocks(std::move(other.blocks)), count(other.count)
+	{
+		other.blocks.clear();
+		other.count = 0;
+	}
+
+	BlockVector& operator=(BlockVector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			for (T* block : blocks)
+				::operator delete(block);
+			blocks = std::move(other.blocks);
+			count = other.count;
+			other.blocks.clear();
+			other.count = 0;
+		}
+		return *this;
+	}
+
+	~BlockVector()
+	{
+		clear();
+		for (T* block : blocks)
+			::operator delete(block);
+	}
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	T& operator[](size_t i) { return *slot(i); }
+	const T& operator[](size_t i) const { return *slot(i); }
+
+	T& back()
+	{
+		assert(count > 0);
+		return *slot(count - 1);
+	}
+
+	void push_back(T&& value)
+	{
+		new (next_slot()) T(std::move(value));
+		count++;
+	}
+
+	void push_back(const T& value)
+	{
+		new (next_slot()) T(value);
+		count++;
+	}
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		T* element = new (next_slot()) T(std::forward<Args>(args)...);
+		count++;
+		return *element;
+	}
+
+	void pop_back()
+	{
+		assert(count > 0);
+		count--;
+		slot(count)->~T();
+	}
+
+	void clear()
+	{
+		while (count > 0)
+			pop_back();
+	}
+
+	void reserve(size_t capacity)
+	{
+		while (blocks.size() * BlockElements < capacity)
+			blocks.push_back(allocate_block());
+	}
+
+	// Contiguous access to a block, e.g. for buffer uploads. Block b holds elements [b * block_capacity, ...)
+	size_t block_count() const { return (count + BlockElements - 1) / BlockElements; }
+	const T* block_data(size_t b) const { return blocks[b]; }
+	size_t block_size(size_t b) const
+	{
+		const size_t begin = b * BlockElements;
+		return count - begin < BlockElements ? count - begin : BlockElements;
+	}
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, count); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, count); }
+};
+
+template <typename T, size_t BlockElements>
+const size_t BlockVector<T, BlockElements>::block_capacity;
@@ -1,28 +1,94 @@
 #pragma once
 
 #include "ecs.hpp"
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
+/*
+	Collisions of the current frame.
+	detect registers candidate pairs, finalize() sorts and de-duplicates them into (low, high) pairs and
+	builds contiguous per-entity neighbour ranges. Removed pairs are only flagged, so spans stay valid
+	for the rest of the frame and simply skip them. All buffers keep their capacity between frames.
+*/
 class CollisionRegistry
 {
 private:
-	std::unordered_map<Entity, std::unordered_set<Entity>> collision_mapping;
-	bool exists_in_both(const std::pair<Entity, Entity>& pairing);
+	struct Contact
+	{
+		Entity owner;
+		Entity other;
+		unsigned int pair; // index into pairs / pair_alive
+	};
+
+	std::vector<std::pair<Entity, Entity>> pairs; // (low, high), sorted once finalized
+	std::vector<unsigned char> pair_alive;
+	std::vector<Contact> contacts; // both directions of every pair, grouped by owner
+	bool finalized = false;
+
+	// Index of the pair in 'pairs', or pairs.size() if not colliding
+	size_t find_pair(const Entity& entity, const Entity& other_entity) const;
 
 	void print_collision_map();
 
 public:
-	CollisionRegistry() {}
-	~CollisionRegistry() {
-		for (auto& collision : collision_mapping)
+	// Range of entities colliding with one entity, skipping pairs removed during this frame
+	class EntitySpan
+	{
+		const Contact* first;
+		const Contact* last;
+		const unsigned char* alive;
+
+	public:
+		class iterator
+		{
+			const Contact* current;
+			const Contact* last;
+			const unsigned char* alive;
+
+			void skip_removed()
+			{
+				while (current != last && !alive[current->pair]) ++current;
+			}
+
+		public:
+			iterator(const Contact* current, const Contact* last, const unsigned char* alive)
+				: current(current), last(last), alive(alive)
+			{
+				skip_removed();
+			}
+
+			const Entity& operator*() const { return current->other; }
+			iterator& operator++() { ++current; skip_removed(); return *this; }
+			bool operator!=(const iterator& other) const { return current != other.current; }
+			bool operator==(const iterator& other) const { return current == other.current; }
+		};
+
+		EntitySpan(const Contact* first, const Contact* last, const unsigned char* alive)
+			: first(first), last(last), alive(alive)
 		{
-			collision.second.clear();
 		}
-		collision_mapping.clear();
+
+		iterator begin() const { return iterator(first, last, alive); }
+		iterator end() const { return iterator(last, last, alive); }
+		bool empty() const { return !(begin() != end()); }
 	};
+
 	void register_collision(const Entity& entity, const Entity& other_entity);
-	std::unordered_set<Entity> get_collision_by_ent(const Entity& entity);
-	bool check_collision(const Entity& entity, const Entity& other_entity);
+	// Sort, de-duplicate and index the registered pairs, lookups are valid afterwards
+	void finalize();
+	EntitySpan get_collision_by_ent(const Entity& entity) const;
+	bool check_collision(const Entity& entity, const Entity& other_entity) const;
 	void remove_collision(const Entity& entity, const Entity& other_entity);
 	void clear_collisions();
-};
\ No newline at end of file
+
+	// Calls f(low, high) for every pair not removed during this frame
+	template <typename F>
+	void each_pair(F f) const
+	{
+		assert(finalized && "Collision lookup before finalize()");
+		for (size_t i = 0; i < pairs.size(); i++)
+		{
+			if (pair_alive[i]) f(pairs[i].first, pairs[i].second);
+		}
+	}
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ecs.hpp"
+
+// Structural changes requested while systems iterate the registry.
+// Nothing is touched until ECSRegistry::flush_commands(), which runs once at the end of WorldSystem::step,
+// so loops over a container can safely destroy the entities they visit.
+class CommandBuffer
+{
+	friend class ECSRegistry;
+
+	// A queued component removal. The container's type is erased into a plain function pointer,
+	// so queueing allocates nothing beyond the vector.
+	struct Removal
+	{
+		void* container;
+		void (*remove_batch)(void* container, const std::vector<Entity>& batch);
+		Entity entity;
+	};
+
+	// Queued component additions of one container. Each container gets its own typed queue,
+	// which keeps its capacity between flushes.
+	class Additions
+	{
+	public:
+		virtual ~Additions() = default;
+		virtual const void* target() const = 0;
+		virtual bool empty() const = 0;
+		virtual void apply() = 0;
+		virtual void clear() = 0;
+	};
+
+	template <typename Component>
+	class TypedAdditions : public Additions
+	{
+	public:
+		ComponentContainer<Component>& container;
+		std::vector<std::pair<Entity, Component>> pending;
+
+		explicit TypedAdditions(ComponentContainer<Component>& container) : container(container)
+		{
+		}
+
+		const void* target() const override { return &container; }
+		bool empty() const override { return pending.empty(); }
+		void clear() override { pending.clear(); }
+
+		// In queued order, entities released since are skipped and a component the entity already holds is replaced
+		void apply() override
+		{
+			for (std::pair<Entity, Component>& addition : pending)
+			{
+				if (!Entity::alive(addition.first)) continue;
+				if (container.has(addition.first))
+					container.get(addition.first) = std::move(addition.second);
+				else
+					container.insert(addition.first, std::move(addition.second));
+			}
+			pending.clear();
+		}
+	};
+
+	// Entities to destroy, removals are grouped per container on flush
+	std::vector<Entity> destroyed;
+	// Single components to remove, grouped per container on flush
+	std::vector<Removal> removals;
+	// Components to add, one queue per container in the order the containers were first added to
+	std::vector<std::unique_ptr<Additions>> additions;
+	// Scratch batch of apply_removals(), kept to avoid allocating on every flush
+	std::vector<Entity> batch;
+
+	template <typename Component>
+	static void remove_batch_from(void* container, const std::vector<Entity>& batch)
+	{
+		static_cast<ComponentContainer<Component>*>(container)->remove_batch(batch);
+	}
+
+	// One remove_batch() per container, entities released since they were queued are skipped
+	void apply_removals()
+	{
+		std::stable_sort(removals.begin(), removals.end(), [](const Removal& a, const Removal& b) {
+			return std::less<void*>()(a.container, b.container);
+		});
+
+		for (size_t first = 0; first < removals.size();)
+		{
+			size_t last = first;
+			batch.clear();
+			for (; last < removals.size() && removals[last].container == removals[first].container; last++)
+			{
+				if (Entity::alive(removals[last].entity)) batch.push_back(removals[last].entity);
+			}
+			if (!batch.empty()) removals[first].remove_batch(removals[first].container, batch);
+			first = last;
+		}
+		removals.clear();
+	}
+
+	void apply_additions()
+	{
+		for (std::unique_ptr<Additions>& queue : additions)
+			queue->apply();
+	}
+
+	template <typename Component>
+	TypedAdditions<Component>& additions_to(ComponentContainer<Component>& container)
+	{
+		for (std::unique_ptr<Additions>& queue : additions)
+		{
+			if (queue->target() == &container) return static_cast<TypedAdditions<Component>&>(*queue);
+		}
+		additions.emplace_back(new TypedAdditions<Component>(container));
+		return static_cast<TypedAdditions<Component>&>(*additions.back());
+	}
+
+public:
+	// Remove all components of e and release its id
+	void destroy(Entity e)
+	{
+		destroyed.push_back(e);
+	}
+
+	// Remove the component of e from container, e.g. commands.remove(registry.debuffs, e)
+	template <typename Component>
+	void remove(ComponentContainer<Component>& container, Entity e)
+	{
+		removals.push_back({ &container, &remove_batch_from<Component>, e });
+	}
+
+	// Add component to e, e.g. commands.add(registry.debuffs, e, debuff)
+	template <typename Component>
+	void add(ComponentContainer<Component>& container, Entity e, Component component)
+	{
+		additions_to(container).pending.emplace_back(e, std::move(component));
+	}
+
+	bool empty() const
+	{
+		if (!destroyed.empty() || !removals.empty()) return false;
+		for (const std::unique_ptr<Additions>& queue : additions)
+		{
+			if (!queue->empty()) return false;
+		}
+		return true;
+	}
+
+	void clear()
+	{
+		destroyed.clear();
+		removals.clear();
+		for (std::unique_ptr<Additions>& queue : additions)
+			queue->clear();
+	}
+};
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "ecs.hpp"
+
+// Position of T in the type list Ts..., used as the static component id
+template <typename T, typename... Ts>
+struct type_index;
+
+template <typename T, typename... Ts>
+struct type_index<T, T, Ts...> : std::integral_constant<unsigned int, 0> {};
+
+template <typename T, typename U, typename... Ts>
+struct type_index<T, U, Ts...> : std::integral_constant<unsigned int, 1 + type_index<T, Ts...>::value> {};
+
+// Stores one ComponentContainer per type in Components, all known at compile time.
+// Operations over every container are expanded over the type list, so no container can be left out.
+template <typename... Components>
+class ComponentRegistry
+{
+	static_assert(sizeof...(Components) <= 64, "ComponentMask has one bit per component type");
+
+	std::tuple<ComponentContainer<Components>...> storage;
+	ComponentSignatures signatures;
+
+	// Per-type entry points so the set bits of a signature can be dispatched without touching other containers
+	using RemoveFunction = void (*)(ComponentRegistry&, Entity);
+	using RemoveBatchFunction = void (*)(ComponentRegistry&, const std::vector<Entity>&);
+
+	template <typename T>
+	static void remove_one(ComponentRegistry& reg, Entity e)
+	{
+		reg.container<T>().remove(e);
+	}
+
+	template <typename T>
+	static void remove_batch_one(ComponentRegistry& reg, const std::vector<Entity>& batch)
+	{
+		reg.container<T>().remove_batch(batch);
+	}
+
+public:
+	ComponentRegistry()
+	{
+		int expand[] = { 0, (container<Components>().bind_signatures(&signatures, ComponentMask(1) << component_id<Components>()), 0)... };
+		(void)expand;
+	}
+
+	// Containers point back into this registry's signature table
+	ComponentRegistry(const ComponentRegistry&) = delete;
+	ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+
+	static constexpr unsigned int component_count = sizeof...(Components);
+
+	// Static id of a component type, its index in the type list
+	template <typename T>
+	static constexpr unsigned int component_id()
+	{
+		return type_index<T, Components...>::value;
+	}
+
+	// Bit of a component type in a signature, see mask_of
+	template <typename T>
+	static constexpr ComponentMask component_bit()
+	{
+		return ComponentMask(1) << component_id<T>();
+	}
+
+	template <typename T>
+	ComponentContainer<T>& container()
+	{
+		return std::get<ComponentContainer<T>>(storage);
+	}
+
+	// Iterate entities holding all of Ts, e.g. registry.view<Motion, Enemy>().each(...)
+	template <typename... Ts>
+	View<Exclude<>, Ts...> view()
+	{
+		return View<Exclude<>, Ts...>(std::make_tuple(&container<Ts>()...), std::tuple<>());
+	}
+
+	// Same as above, skipping entities holding any of Excluded, e.g. registry.view<Motion>(exclude<Death>)
+	template <typename... Ts, typename... Excluded>
+	View<Exclude<Excluded...>, Ts...> view(Exclude<Excluded...>)
+	{
+		return View<Exclude<Excluded...>, Ts...>(std::make_tuple(&container<Ts>()...), std::make_tuple(&container<Excluded>()...));
+	}
+
+	// Entities holding all of Lead and Others, kept at the front of each of those containers in matching order.
+	// The first call sets the group up and takes ownership of the containers. From then on removals keep it aligned
+	// and entities that completed it are moved in by the next call, so each call only moves the entities that joined
+	// since the last one. Those moves relocate components: do not hold references into these containers across this call.
+	template <typename Lead, typename... Others>
+	Group<Lead, Others...> group()
+	{
+		GroupOwner* owner = container<Lead>().get_owner();
+		if (!owner)
+		{
+			groups.emplace_back(new OwnedGroup<Lead, Others...>(*this));
+			owner = groups.back().get();
+		}
+		return static_cast<OwnedGroup<Lead, Others...>*>(owner)->get();
+	}
+
+	// Bit i is set if e has the component with id i
+	ComponentMask mask_of(Entity e) const
+	{
+		return signatures.get(e);
+	}
+
+	void clear_containers()
+	{
+		int expand[] = { 0, (container<Components>().clear(), 0)... };
+		(void)expand;
+	}
+
+	// Only the containers holding e are visited
+	void remove_from_containers(Entity e)
+	{
+		static const RemoveFunction remove_functions[] = { &remove_one<Components>... };
+		ComponentMask mask = signatures.get(e);
+		for (unsigned int id = 0; mask != 0; id++, mask >>= 1)
+			if (mask & 1) remove_functions[id](*this, e);
+	}
+
+	// Only the containers holding at least one entity of the batch are visited
+	void remove_batch_from_containers(const std::vector<Entity>& batch)
+	{
+		static const RemoveBatchFunction remove_functions[] = { &remove_batch_one<Components>... };
+		ComponentMask mask = 0;
+		for (const Entity& e : batch)
+			mask |= signatures.get(e);
+		for (unsigned int id = 0; mask != 0; id++, mask >>= 1)
+			if (mask & 1) remove_functions[id](*this, batch);
+	}
+
+	void list_all_components()
+	{
+		printf("Debug info on all registry entries:\n");
+		int expand[] = { 0, (print_size<Components>(), 0)... };
+		(void)expand;
+	}
+
+	void list_all_components_of(Entity e)
+	{
+		printf("Debug info on components of entity %u:\n", (unsigned int)e);
+		int expand[] = { 0, (container<Components>().has(e) ? printf("type %s\n", typeid(ComponentContainer<Components>).name()) : 0)... };
+		(void)expand;
+	}
+
+private:
+	// Members occupy [0, count) of every owned container in the same order
+	template <typename Lead, typename... Others>
+	class OwnedGroup final : public GroupOwner
+	{
+		ComponentRegistry& registry;
+		ComponentMask mask;
+		unsigned int count = 0;
+		// Entities that completed the group since the last get(), they are moved in there
+		std::vector<Entity> joining;
+
+		bool contains(Entity e)
+		{
+			ComponentContainer<Lead>& lead = registry.container<Lead>();
+			return lead.has(e) && lead.index_of(e) < count;
+		}
+
+		bool qualifies(Entity e) const
+		{
+			return (registry.mask_of(e) & mask) == mask;
+		}
+
+		template <typename T>
+		void move_one(Entity e, unsigned int position)
+		{
+			ComponentContainer<T>& target = registry.container<T>();
+			target.swap_positions(position, target.index_of(e));
+		}
+
+		// Put e at position in every owned container
+		void move_to(Entity e, unsigned int position)
+		{
+			move_one<Lead>(e, position);
+			int expand[] = { 0, (move_one<Others>(e, position), 0)... };
+			(void)expand;
+		}
+
+	public:
+		explicit OwnedGroup(ComponentRegistry& registry)
+			: registry(registry), mask(component_bit<Lead>())
+		{
+			int expand_mask[] = { 0, (mask |= component_bit<Others>(), 0)... };
+			(void)expand_mask;
+
+			registry.container<Lead>().set_owner(this);
+			int expand_owner[] = { 0, (registry.container<Others>().set_owner(this), 0)... };
+			(void)expand_owner;
+
+			// Everything already present joins once
+			joining = registry.container<Lead>().entities;
+		}
+
+		~OwnedGroup()
+		{
+			registry.container<Lead>().set_owner(nullptr);
+			int expand[] = { 0, (registry.container<Others>().set_owner(nullptr), 0)... };
+			(void)expand;
+		}
+
+		void on_insert(Entity e) override
+		{
+			if (qualifies(e)) joining.push_back(e);
+		}
+
+		void on_remove(Entity e) override
+		{
+			if (!contains(e)) return;
+			count--;
+			move_to(e, count);
+		}
+
+		void on_clear() override
+		{
+			count = 0;
+			joining.clear();
+		}
+
+		Group<Lead, Others...> get()
+		{
+			for (const Entity& e : joining)
+			{
+				// Entries may have lost a component or been destroyed since they were queued
+				if (qualifies(e) && !contains(e))
+				{
+					move_to(e, count);
+					count++;
+				}
+			}
+			joining.clear();
+			return Group<Lead, Others...>(count, &registry.container<Lead>(), std::make_tuple(&registry.container<Others>()...));
+		}
+	};
+
+	std::vector<std::unique_ptr<GroupOwner>> groups;
+
+	template <typename T>
+	void print_size()
+	{
+		if (container<T>().size() > 0)
+			printf("%4d components of type %s\n", (int)container<T>().size(), typeid(ComponentContainer<T>).name());
+	}
+};
@@ -2,21 +2,49 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <tuple>
 #include <vector>
-#include <unordered_map>
 #include <assert.h>
 
+#include "block_vector.hpp"
+
 // Unique identifier for all entities
+// The handle packs a slot index (low bits) with a generation counter (high bits). Released slots are
+// recycled through a FIFO free list and their generation is bumped, so stale handles stop comparing equal.
+// A slot is only re-used once MINIMUM_FREE_INDICES others wait before it, so its generation wraps after
+// millions of releases rather than within a few thousand frames.
 class Entity
 {
 	unsigned int id;
-	static unsigned int id_count; // starts from 1, entit 0 is the default initialization
+	static unsigned int id_count; // starts from 1, entity 0 is the null handle
+
+	static std::vector<unsigned int>& generations();
+	static std::deque<unsigned int>& free_indices();
 public:
-	Entity()
-	{
-		id = id_count++;
-		// Note, indices of already deleted entities arent re-used in this simple implementation.
-	}
+	static const unsigned int INDEX_BITS = 20;
+	static const unsigned int INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static const unsigned int GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+	static const unsigned int MINIMUM_FREE_INDICES = 1024;
+
+	// The null handle, never alive. Declaring a handle does not allocate one, see create()
+	Entity() : id(0) {}
+
+	// Allocate a new entity, aborts once all INDEX_MASK indices are in use
+	static Entity create();
+
+	// Slot of this entity, stable for its lifetime and re-used after release
+	unsigned int index() const { return id & INDEX_MASK; }
+	unsigned int generation() const { return id >> INDEX_BITS; }
+
+	// True while the handle has not been released
+	static bool alive(Entity e);
+	// Return the slot of e to the free list, invalidating every copy of the handle
+	static void release(Entity e);
+	// Invalidate every handle handed out so far and hand out indices from 1 again, used when the whole registry is cleared
+	static void release_all();
 
 	operator unsigned int() const { return id; }
 	bool operator ==(const Entity& other) const {
@@ -33,26 +61,111 @@ namespace std {
 	};
 }
 
-// Common interface to refer to all containers in the ECS registry
-struct ContainerInterface
+// One bit per component type, see ComponentRegistry::component_id
+using ComponentMask = uint64_t;
+
+// Dense per-entity record of which containers hold the entity, indexed by Entity::index().
+// The full handle is stored next to the mask, so a stale handle never reads the mask of the entity re-using its slot.
+class ComponentSignatures
 {
-	virtual void clear() = 0;
-	virtual size_t size() = 0;
-	virtual void remove(Entity e) = 0;
-	virtual bool has(Entity entity) = 0;
+	struct Slot
+	{
+		unsigned int handle = 0;
+		ComponentMask mask = 0;
+	};
+	std::vector<Slot> slots;
+
+public:
+	void set(Entity e, ComponentMask bit)
+	{
+		if (e.index() >= slots.size()) slots.resize(e.index() + 1);
+		Slot& slot = slots[e.index()];
+		if (slot.handle != (unsigned int)e)
+		{
+			slot.handle = e;
+			slot.mask = 0;
+		}
+		slot.mask |= bit;
+	}
+
+	void reset(Entity e, ComponentMask bit)
+	{
+		if (e.index() < slots.size() && slots[e.index()].handle == (unsigned int)e)
+			slots[e.index()].mask &= ~bit;
+	}
+
+	ComponentMask get(Entity e) const
+	{
+		if (e.index() < slots.size() && slots[e.index()].handle == (unsigned int)e)
+			return slots[e.index()].mask;
+		return 0;
+	}
+
+	bool test(Entity e, ComponentMask bit) const
+	{
+		return (get(e) & bit) != 0;
+	}
+};
+
+// Keeps an owning group aligned with the containers it owns, see ComponentRegistry::group()
+class GroupOwner
+{
+public:
+	virtual ~GroupOwner() = default;
+	// After a component of e was appended to an owned container
+	virtual void on_insert(Entity e) = 0;
+	// Before a component of e is removed from an owned container
+	virtual void on_remove(Entity e) = 0;
+	virtual void on_clear() = 0;
 };
 
 // A container that stores components of type 'Component' and associated entities
 template <typename Component> // A component can be any class
-class ComponentContainer : public ContainerInterface
+class ComponentContainer
 {
 private:
-	// The hash map from Entity -> array index.
-	std::unordered_map<unsigned int, unsigned int> map_entity_componentID; // the entity is cast to uint to be hashable.
+	// Paged sparse array from Entity::index() -> dense array index. Pages are only allocated once an entity in
+	// their range receives this component, so sparse ids do not require one large table.
+	enum : unsigned int
+	{
+		PAGE_BITS = 12,
+		PAGE_SIZE = 1u << PAGE_BITS,
+		INVALID_INDEX = 0xFFFFFFFF
+	};
+	std::vector<std::vector<unsigned int>> sparse_pages;
 	bool registered = false;
+
+	// Shared signature table and this container's bit in it, set by the owning registry
+	ComponentSignatures* signatures = nullptr;
+	ComponentMask signature_bit = 0;
+
+	// Scratch buffer of sort(), kept to avoid allocating on every sort
+	std::vector<unsigned int> permutation;
+
+	// Receives components inserted through dead handles in release builds, they are dropped
+	std::unique_ptr<Component> discarded;
+
+	// Group this container belongs to, if any, notified of every insert and removal
+	GroupOwner* owner = nullptr;
+
+	unsigned int sparse_get(unsigned int id) const
+	{
+		const unsigned int page = id >> PAGE_BITS;
+		if (page >= sparse_pages.size() || sparse_pages[page].empty()) return INVALID_INDEX;
+		return sparse_pages[page][id & (PAGE_SIZE - 1)];
+	}
+
+	void sparse_set(unsigned int id, unsigned int index)
+	{
+		const unsigned int page = id >> PAGE_BITS;
+		if (page >= sparse_pages.size()) sparse_pages.resize(page + 1);
+		if (sparse_pages[page].empty()) sparse_pages[page].assign(PAGE_SIZE, INVALID_INDEX);
+		sparse_pages[page][id & (PAGE_SIZE - 1)] = index;
+	}
 public:
 	// Container of all components of type 'Component'
-	std::vector<Component> components;
+	// Stored in fixed-size blocks, so references stay valid while other components are added
+	BlockVector<Component> components;
 
 	// The corresponding entities
 	std::vector<Entity> entities;
@@ -62,15 +175,45 @@ public:
 	{
 	}
 
+	// Keep 'table' up to date with this container's membership, has() then becomes a bit test
+	void bind_signatures(ComponentSignatures* table, ComponentMask bit)
+	{
+		assert(entities.empty() && "Bind signatures before inserting components");
+		signatures = table;
+		signature_bit = bit;
+	}
+
+	GroupOwner* get_owner() const
+	{
+		return owner;
+	}
+
+	void set_owner(GroupOwner* group)
+	{
+		assert((!owner || !group) && "A container can only be owned by one group");
+		owner = group;
+	}
+
 	// Inserting a component c associated to entity e
 	inline Component& insert(Entity e, Component c, bool check_for_duplicates = true)
 	{
+		// A stale handle shares its index with a live entity, inserting through it would take over that entity's slot
+		assert(Entity::alive(e) && "Inserting into a null or released entity");
+		if (!Entity::alive(e))
+		{
+			discarded.reset(new Component(std::move(c)));
+			return *discarded;
+		}
+
 		// Usually, every entity should only have one instance of each component type
 		assert(!(check_for_duplicates && has(e)) && "Entity already contained in ECS registry");
 
-		map_entity_componentID[e] = (unsigned int)components.size();
+		sparse_set(e.index(), (unsigned int)components.size());
+		if (signatures) signatures->set(e, signature_bit);
 		components.push_back(std::move(c)); // the move enforces move instead of copy constructor
 		entities.push_back(e);
+		// Only queues e to join a group, the components stay where they are
+		if (owner) owner->on_insert(e);
 		return components.back();
 	};
 
@@ -86,13 +229,17 @@ public:
 
 	// A wrapper to return the component of an entity
 	Component& get(Entity e) {
-		assert(has(e) && "Entity not contained in ECS registry");
-		return components[map_entity_componentID[e]];
+		const unsigned int index = sparse_get(e.index());
+		assert(index < entities.size() && entities[index] == e && "Entity not contained in ECS registry");
+		return components[index];
 	}
 
-	// Check if entity has a component of type 'Component'
+	// Check if entity has a component of type 'Component'.
+	// The signature bit rejects most entities without a lookup, the stored handle then confirms the generation.
 	bool has(Entity entity) {
-		return map_entity_componentID.count(entity) > 0;
+		if (signatures && !signatures->test(entity, signature_bit)) return false;
+		const unsigned int index = sparse_get(entity.index());
+		return index < entities.size() && entities[index] == entity;
 	}
 
 	// Remove an component and pack the container to re-use the empty space
@@ -100,29 +247,89 @@ public:
 	{
 		if (has(e))
 		{
+			// Leave the group first, so the swap below only ever moves components outside of it
+			if (owner) owner->on_remove(e);
+
 			// Get the current position
-			int cID = map_entity_componentID[e];
+			unsigned int cID = sparse_get(e.index());
 
 			// Move the last element to position cID using the move operator
 			// Note, components[cID] = components.back() would trigger the copy instead of move operator
 			components[cID] = std::move(components.back());
 			entities[cID] = entities.back(); // the entity is only a single index, copy it.
-			map_entity_componentID[entities.back()] = cID;
+			sparse_set(entities.back().index(), cID);
 
 			// Erase the old component and free its memory
-			map_entity_componentID.erase(e);
+			sparse_set(e.index(), INVALID_INDEX);
+			if (signatures) signatures->reset(e, signature_bit);
 			components.pop_back();
 			entities.pop_back();
 			// Note, one could mark the id for re-use
 		}
 	};
 
+	// Remove the components of every entity in batch. A few removals are done by swap-and-pop,
+	// larger batches compact the container in a single pass (which also keeps the remaining order)
+	void remove_batch(const std::vector<Entity>& batch)
+	{
+		if (batch.size() * 4 < components.size())
+		{
+			for (const Entity& e : batch)
+				remove(e);
+			return;
+		}
+
+		// Group members leave before anything is marked, leaving swaps positions
+		if (owner)
+		{
+			for (const Entity& e : batch)
+				if (has(e)) owner->on_remove(e);
+		}
+
+		bool any_marked = false;
+		for (const Entity& e : batch)
+		{
+			if (has(e))
+			{
+				sparse_set(e.index(), INVALID_INDEX);
+				if (signatures) signatures->reset(e, signature_bit);
+				any_marked = true;
+			}
+		}
+		if (!any_marked) return;
+
+		unsigned int write = 0;
+		for (unsigned int read = 0; read < entities.size(); read++)
+		{
+			const Entity e = entities[read];
+			if (sparse_get(e.index()) == INVALID_INDEX) continue;
+			if (write != read)
+			{
+				components[write] = std::move(components[read]);
+				entities[write] = e;
+			}
+			sparse_set(e.index(), write);
+			write++;
+		}
+		while (components.size() > write)
+		{
+			components.pop_back();
+			entities.pop_back();
+		}
+	}
+
 	// Remove all components of type 'Component'
 	void clear()
 	{
-		map_entity_componentID.clear();
+		// Only reset the slots in use, the pages themselves are kept for re-use
+		for (const Entity& e : entities)
+		{
+			sparse_set(e.index(), INVALID_INDEX);
+			if (signatures) signatures->reset(e, signature_bit);
+		}
 		components.clear();
 		entities.clear();
+		if (owner) owner->on_clear();
 	}
 
 	// Report the number of components of type 'Component'
@@ -131,18 +338,148 @@ public:
 		return components.size();
 	}
 
+	// Position of e in the dense arrays, e must be contained
+	unsigned int index_of(Entity e) const
+	{
+		return sparse_get(e.index());
+	}
+
+	// Exchange two dense positions (moves the components, so references to either are invalidated)
+	void swap_positions(unsigned int a, unsigned int b)
+	{
+		if (a == b) return;
+		std::swap(components[a], components[b]);
+		std::swap(entities[a], entities[b]);
+		sparse_set(entities[a].index(), a);
+		sparse_set(entities[b].index(), b);
+	}
+
 	// Sort the components and associated entity assignment structures by the comparisonFunction, see std::sort
+	// The components are permuted in place by following the cycles of the permutation, only a reused index buffer is needed.
 	template <class Compare>
 	void sort(Compare comparisonFunction)
 	{
+		assert(!owner && "Sorting would break the order of the group owning this container");
 		// First sort the entity list as desired
 		std::sort(entities.begin(), entities.end(), comparisonFunction);
-		// Now re-arrange the components (Note, creates a new vector, which may be slow! Not sure if in-place could be faster: https://stackoverflow.com/questions/63703637/how-to-efficiently-permute-an-array-in-place-using-stdswap)
-		std::vector<Component> components_new; components_new.reserve(components.size());
-		std::transform(entities.begin(), entities.end(), std::back_inserter(components_new), [&](Entity e) { return std::move(get(e)); }); // note, the get still uses the old hash map (on purpose!)
-		components = std::move(components_new); // note, we use move operations to not create unneccesary copies of objects, but memory is still allocated for the new vector
-		// Fill the new hashmap
+
+		// The sparse array still holds the old indices (on purpose!), so it tells where each component comes from
+		permutation.resize(entities.size());
 		for (unsigned int i = 0; i < entities.size(); i++)
-			map_entity_componentID[entities[i]] = i;
+			permutation[i] = sparse_get(entities[i].index());
+
+		for (unsigned int start = 0; start < permutation.size(); start++)
+		{
+			if (permutation[start] == start) continue;
+
+			Component displaced = std::move(components[start]);
+			unsigned int current = start;
+			while (true)
+			{
+				const unsigned int source = permutation[current];
+				permutation[current] = current;
+				if (source == start)
+				{
+					components[current] = std::move(displaced);
+					break;
+				}
+				components[current] = std::move(components[source]);
+				current = source;
+			}
+		}
+
+		// Point the sparse array at the new positions
+		for (unsigned int i = 0; i < entities.size(); i++)
+			sparse_set(entities[i].index(), i);
+	}
+};
+
+// Component types an entity must NOT have to be visited by a View, e.g. registry.view<Motion>(exclude<Death>)
+template <typename... Excluded>
+struct Exclude {};
+
+template <typename... Excluded>
+constexpr Exclude<Excluded...> exclude{};
+
+// Iterates all entities that have every component in Components and none of the Excluded ones.
+// Walks the smallest participating container and only probes the others for each candidate.
+template <typename ExcludeList, typename... Components>
+class View;
+
+template <typename... Excluded, typename... Components>
+class View<Exclude<Excluded...>, Components...>
+{
+	static_assert(sizeof...(Components) > 0, "A view needs at least one component type");
+
+	std::tuple<ComponentContainer<Components>*...> included;
+	std::tuple<ComponentContainer<Excluded>*...> excluded;
+
+	bool matches(Entity e)
+	{
+		bool match = true;
+		int expand_included[] = { 0, (match = match && std::get<ComponentContainer<Components>*>(included)->has(e), 0)... };
+		int expand_excluded[] = { 0, (match = match && !std::get<ComponentContainer<Excluded>*>(excluded)->has(e), 0)... };
+		(void)expand_included; (void)expand_excluded;
+		return match;
+	}
+
+	const std::vector<Entity>& smallest()
+	{
+		const std::vector<Entity>* lists[] = { &std::get<ComponentContainer<Components>*>(included)->entities... };
+		const std::vector<Entity>* best = lists[0];
+		for (const std::vector<Entity>* list : lists)
+			if (list->size() < best->size()) best = list;
+		return *best;
+	}
+
+public:
+	View(std::tuple<ComponentContainer<Components>*...> included, std::tuple<ComponentContainer<Excluded>*...> excluded)
+		: included(included), excluded(excluded)
+	{
+	}
+
+	// Calls f(Entity, Components&...) for every matching entity.
+	// f may add components or mark entities, the driving list is re-read by index on every step.
+	template <typename Func>
+	void each(Func f)
+	{
+		const std::vector<Entity>& lead = smallest();
+		for (size_t i = 0; i < lead.size(); i++)
+		{
+			const Entity e = lead[i];
+			if (!matches(e)) continue;
+			f(e, std::get<ComponentContainer<Components>*>(included)->get(e)...);
+		}
+	}
+};
+
+// Lockstep iteration over containers whose first size() entries hold the same entities in the same order,
+// see ComponentRegistry::group(). Component i of every container belongs to the same entity.
+template <typename Lead, typename... Others>
+class Group
+{
+	size_t count;
+	ComponentContainer<Lead>* lead;
+	std::tuple<ComponentContainer<Others>*...> others;
+
+public:
+	Group(size_t count, ComponentContainer<Lead>* lead, std::tuple<ComponentContainer<Others>*...> others)
+		: count(count), lead(lead), others(others)
+	{
+	}
+
+	// Number of entities in the group, they occupy indices [0, size()) of every grouped container
+	size_t size() const
+	{
+		return count;
+	}
+
+	// Calls f(Entity, Lead&, Others&...) for every entity of the group without any lookups.
+	// f must not add or remove grouped components.
+	template <typename Func>
+	void each(Func f)
+	{
+		for (size_t i = 0; i < count; i++)
+			f(lead->entities[i], lead->components[i], std::get<ComponentContainer<Others>*>(others)->components[i]...);
 	}
 };
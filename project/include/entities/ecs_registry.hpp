@@ -2,46 +2,92 @@
 #include <vector>
 
 #include "ecs.hpp"
+#include "component_registry.hpp"
 #include "general_components.hpp"
 #include "collision_registry.hpp"
+#include "command_buffer.hpp"
 #include "ai/ai_system.hpp"
 
-class ECSRegistry
+// Every component type this game has. Adding a type here is all that is needed for it to be
+// cleared, removed and listed with the rest; give it a named accessor below for convenience.
+using GameComponentRegistry = ComponentRegistry<
+	Motion,
+	Health,
+	HealthBar,
+	ResistanceModifier,
+	Collision,
+	SpellState,
+	Player,
+	Enemy,
+	Deadly,
+	Death,
+	Projectile,
+	Interactable,
+	Damage,
+	OnHit,
+	OnHeal,
+	RenderRequest,
+	Animation,
+	Camera,
+	Tile,
+	Particle,
+	DebugRequest,
+	MeshCollider,
+	AIComponent,
+	SpellUnlock,
+	Decay,
+	Debuff,
+	SpellProjectile,
+	CollisionLayer,
+	SweptCollider
+>;
+
+class ECSRegistry : public GameComponentRegistry
 {
-	// Callbacks to remove a particular or all entities in the system
-	std::vector<ContainerInterface*> registry_list;
+	// Behaviour trees are heap allocated and owned by the AI component
+	void clean_ai_of(Entity e)
+	{
+		if (ai_systems.has(e)) {
+			auto& ai = ai_systems.get(e);
+			if (ai.root) {
+				AI_SYSTEM::cleanNodeTree(ai.root);
+			}
+		}
+	}
 
 public:
-	// Manually created list of all components this game has
-	ComponentContainer<Motion> motions;
-	ComponentContainer<Health> healths;
-	ComponentContainer<HealthBar> healthBars;
-	ComponentContainer<ResistanceModifier> resistanceModifiers;
-	ComponentContainer<Collision> collisions;
-	ComponentContainer<SpellState> spellStates;
-	ComponentContainer<Player> players;
-	ComponentContainer<Enemy> enemies;
-	ComponentContainer<Deadly> deadlies;
-	ComponentContainer<Death> deaths;
-	ComponentContainer<Projectile> projectiles;
-	ComponentContainer<Interactable> interactables;
-	ComponentContainer<Damage> damages;
-	ComponentContainer<OnHit> onHits;
-	ComponentContainer<OnHeal> onHeals;
-	ComponentContainer<RenderRequest> render_requests;
-	ComponentContainer<RenderRequest> static_render_requests;
-	ComponentContainer<Animation> animations;
-	ComponentContainer<Camera> cameras;
-	ComponentContainer<Tile> tiles;
-	ComponentContainer<Particle> particles;
-	ComponentContainer<DebugRequest> debug_requests;
-	ComponentContainer<MeshCollider> mesh_colliders;
-	ComponentContainer<AIComponent> ai_systems;
-	ComponentContainer<SpellUnlock> spellUnlocks;
-	ComponentContainer<Decay> decays;
-	ComponentContainer<Debuff> debuffs;
-	ComponentContainer<SpellProjectile> spellProjectiles;
+	// Named access to the containers
+	ComponentContainer<Motion>& motions = container<Motion>();
+	ComponentContainer<Health>& healths = container<Health>();
+	ComponentContainer<HealthBar>& healthBars = container<HealthBar>();
+	ComponentContainer<ResistanceModifier>& resistanceModifiers = container<ResistanceModifier>();
+	ComponentContainer<Collision>& collisions = container<Collision>();
+	ComponentContainer<SpellState>& spellStates = container<SpellState>();
+	ComponentContainer<Player>& players = container<Player>();
+	ComponentContainer<Enemy>& enemies = container<Enemy>();
+	ComponentContainer<Deadly>& deadlies = container<Deadly>();
+	ComponentContainer<Death>& deaths = container<Death>();
+	ComponentContainer<Projectile>& projectiles = container<Projectile>();
+	ComponentContainer<Interactable>& interactables = container<Interactable>();
+	ComponentContainer<Damage>& damages = container<Damage>();
+	ComponentContainer<OnHit>& onHits = container<OnHit>();
+	ComponentContainer<OnHeal>& onHeals = container<OnHeal>();
+	ComponentContainer<RenderRequest>& render_requests = container<RenderRequest>();
+	ComponentContainer<Animation>& animations = container<Animation>();
+	ComponentContainer<Camera>& cameras = container<Camera>();
+	ComponentContainer<Tile>& tiles = container<Tile>();
+	ComponentContainer<Particle>& particles = container<Particle>();
+	ComponentContainer<DebugRequest>& debug_requests = container<DebugRequest>();
+	ComponentContainer<MeshCollider>& mesh_colliders = container<MeshCollider>();
+	ComponentContainer<AIComponent>& ai_systems = container<AIComponent>();
+	ComponentContainer<SpellUnlock>& spellUnlocks = container<SpellUnlock>();
+	ComponentContainer<Decay>& decays = container<Decay>();
+	ComponentContainer<Debuff>& debuffs = container<Debuff>();
+	ComponentContainer<SpellProjectile>& spellProjectiles = container<SpellProjectile>();
+	ComponentContainer<CollisionLayer>& collisionLayers = container<CollisionLayer>();
+	ComponentContainer<SweptCollider>& sweptColliders = container<SweptCollider>();
 	CollisionRegistry collision_registry;
+	CommandBuffer commands;
 	float worldTimer = START_WORLD_TIME;
 	mat4 viewMatrix;
 	mat4 projectionMatrix;
@@ -49,70 +95,56 @@ public:
 	bool game_over = false;
 	bool debug = false;
 
-	// constructor that adds all containers for looping over them
-	// IMPORTANT: Don't forget to add any newly added containers!
-	ECSRegistry()
+	// False once all components of e were removed (or the registry was cleared), even if its slot was re-used
+	bool valid(Entity e) const
 	{
-		registry_list.push_back(&motions);
-		registry_list.push_back(&healths);
-		registry_list.push_back(&healthBars);
-		registry_list.push_back(&resistanceModifiers);
-		registry_list.push_back(&collisions);
-		registry_list.push_back(&spellStates);
-		registry_list.push_back(&players);
-		registry_list.push_back(&enemies);
-		registry_list.push_back(&deadlies);
-		registry_list.push_back(&deaths);
-		registry_list.push_back(&projectiles);
-		registry_list.push_back(&interactables);
-		registry_list.push_back(&damages);
-		registry_list.push_back(&onHits);
-		registry_list.push_back(&onHeals);
-		registry_list.push_back(&render_requests);
-		registry_list.push_back(&animations);
-		registry_list.push_back(&cameras);
-		registry_list.push_back(&static_render_requests);
-		registry_list.push_back(&tiles);
-		registry_list.push_back(&particles);
-		registry_list.push_back(&ai_systems);
-		registry_list.push_back(&spellUnlocks);
-		registry_list.push_back(&decays);
-		registry_list.push_back(&spellProjectiles);
+		return Entity::alive(e);
 	}
 
-	void clear_all_components() const
+	void clear_all_components()
 	{
-		for (ContainerInterface* reg : registry_list)
-			reg->clear();
+		commands.clear();
+		clear_containers();
+		Entity::release_all();
 	}
 
-	void list_all_components() const
+	void remove_all_components_of(Entity e)
 	{
-		printf("Debug info on all registry entries:\n");
-		for (ContainerInterface* reg : registry_list)
-			if (reg->size() > 0)
-				printf("%4d components of type %s\n", (int)reg->size(), typeid(*reg).name());
+		clean_ai_of(e);
+		remove_from_containers(e);
+		Entity::release(e);
 	}
 
-	void list_all_components_of(Entity e) const
+	// Apply everything queued in 'commands': removals, then additions, then destroyed entities, so destroying
+	// wins over anything else queued for the same entity. Removals and destroyed entities are applied with one
+	// batch per container, entities that were released in the meantime are skipped.
+	void flush_commands()
 	{
-		printf("Debug info on components of entity %u:\n", (unsigned int)e);
-		for (ContainerInterface* reg : registry_list)
-			if (reg->has(e))
-				printf("type %s\n", typeid(*reg).name());
+		commands.apply_removals();
+		commands.apply_additions();
+
+		std::vector<Entity>& doomed = commands.destroyed;
+		if (doomed.empty()) return;
+
+		// Drop duplicates and handles that were already released
+		std::sort(doomed.begin(), doomed.end(), [](const Entity& a, const Entity& b) { return (unsigned int)a < (unsigned int)b; });
+		doomed.erase(std::unique(doomed.begin(), doomed.end()), doomed.end());
+		doomed.erase(std::remove_if(doomed.begin(), doomed.end(), [](const Entity& e) { return !Entity::alive(e); }), doomed.end());
+
+		for (const Entity& e : doomed)
+			clean_ai_of(e);
+		remove_batch_from_containers(doomed);
+		for (const Entity& e : doomed)
+			Entity::release(e);
+		doomed.clear();
 	}
 
-	void remove_all_components_of(Entity e)
+	// Debug requests are re-created every tick, so their entities are released along with them
+	void clear_debug_requests()
 	{
-		if (ai_systems.has(e)) {
-			auto& ai = ai_systems.get(e);
-			if (ai.root) {
-				AI_SYSTEM::cleanNodeTree(ai.root);
-			}
-		}
-
-		for (ContainerInterface* reg : registry_list)
-			reg->remove(e);
+		for (const Entity& e : debug_requests.entities)
+			Entity::release(e);
+		debug_requests.clear();
 	}
 
 	void reset_registry()
@@ -174,18 +174,58 @@ struct Deadly
     bool to_projectile = false;
 };
 
-// Smooth position component to handle z-fighting
+// Collision layers, an entity can be on several
+enum CollisionLayerBit : uint32_t
+{
+    LAYER_PLAYER = 1u << 0,
+    LAYER_ENEMY = 1u << 1,
+    LAYER_PROJECTILE = 1u << 2,
+    LAYER_INTERACTABLE = 1u << 3,
+};
+
+// Collision filter derived from the entity's role, see assignCollisionLayer.
+// A pair is only generated if either side's mask contains the other's layer; entities without one never collide.
+struct CollisionLayer
+{
+    uint32_t layer = 0;
+    uint32_t mask = 0;
+};
+
+// Fast moving collider, tested along its whole movement of the tick instead of only at its end position
+struct SweptCollider
+{
+    vec2 start_position = { 0, 0 };
+};
+
+// Smooth position component to handle z-fighting, and to interpolate between simulation ticks
 struct SmoothPosition {
     float render_y;
     static constexpr float HYSTERESIS = 5.0f;
     static constexpr float SMOOTHING_FACTOR = 0.1f;
 
+    // Positions at the end of the last two ticks
+    vec2 previous = { 0.f, 0.f };
+    vec2 current = { 0.f, 0.f };
+    bool has_snapshot = false;
+
     void update(const float actual_y) {
         const float diff = actual_y - render_y;
         if (std::abs(diff) > HYSTERESIS) {
             render_y += diff * SMOOTHING_FACTOR;
         }
     }
+
+    // Record the position at the end of a tick, the first one starts without movement
+    void snapshot(const vec2& position) {
+        previous = has_snapshot ? current : position;
+        current = position;
+        has_snapshot = true;
+    }
+
+    // Position alpha (0 to 1) of the way from the previous tick to the last one, or fallback before any tick
+    vec2 interpolate(const vec2& fallback, float alpha) const {
+        return has_snapshot ? previous + (current - previous) * alpha : fallback;
+    }
 };
 
 struct RenderRequest
@@ -265,6 +305,12 @@ struct GlobalOptions {
 
     // -- DEBUG options, will refactor --
     bool debugSpellSpawn = false;
+
+    // -- Startup options, set from the command line --
+    BroadphaseType broadphase = BroadphaseType::GRID;
+    int tick_rate = DEFAULT_TICK_RATE;                     // simulation ticks per second
+    int max_steps_per_frame = DEFAULT_MAX_STEPS_PER_FRAME; // time beyond this many ticks is dropped
+    bool cutscenes = true;                                 // off while recording or replaying, a video's length is not reproducible
 };
 
 extern GlobalOptions globalOptions;
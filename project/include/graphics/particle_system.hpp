@@ -3,7 +3,6 @@
 #include "entities/general_components.hpp"
 #include "entities/ecs_registry.hpp"
 #include <array>
-#include <random>
 
 class ParticleSystem {
 public:
@@ -1,11 +1,12 @@
 #include <vector>
-#include <random>
 
 #include "entities/ecs_registry.hpp"
 
 #include "utils/isometric_helper.hpp"
 #include "entities/general_components.hpp"
 #include "graphics/batch_renderer.hpp"
+#include "core/occupancy_grid.hpp"
+#include "utils/rng.hpp"
 
 class TileGenerator
 {
@@ -13,20 +14,18 @@ private:
     int numRows, numCols;
     int w, h;
     std::vector<std::vector<float>> noiseMap;
-    std::random_device rd;
-    std::mt19937 gen;
 
     // learned from https://www.youtube.com/watch?v=slTEz6555Ts
     void generateNoiseMap()
     {
         noiseMap.resize(numRows, std::vector<float>(numCols));
 
-        std::uniform_real_distribution<> dis(0.0, 1.0);
+        Pcg32& rng = rng_service.stream(RngStream::TERRAIN);
         for (int row = 0; row < numRows; row++)
         {
             for (int col = 0; col < numCols; col++)
             {
-                noiseMap[row][col] = dis(gen);
+                noiseMap[row][col] = rng.uniform(0.f, 1.f);
             }
         }
 
@@ -74,14 +73,37 @@ public:
     TileGenerator(int rows, int cols, int w, int h,
                   bool safetyMultiplier = true) : numRows(rows * (safetyMultiplier ? 3 : 1)),
                                                   numCols(cols * (safetyMultiplier ? 3 : 1)),
-                                                  w(w), h(h), gen(rd()) {
+                                                  w(w), h(h) {
         generateNoiseMap();
     }
 
     ~TileGenerator() {
     }
 
+    // Size the grid to the tiles, one cell per tile laid out like generateTiles, and block every tile whose noise is above blockedNoise
+    void bakeOccupancy(OccupancyGrid& grid, float blockedNoise) const {
+        vec2 offset = {-w , -h / 2};
+        const vec2 origin = IsometricGrid::getIsometricPosition(0, 0, true);
+        grid.reset(origin + offset,
+                   IsometricGrid::getIsometricPosition(1, 0, true) - origin,
+                   IsometricGrid::getIsometricPosition(0, 1, true) - origin,
+                   numCols, numRows);
+
+        for (int row = 0; row < numRows; row++)
+        {
+            for (int col = 0; col < numCols; col++)
+            {
+                if (noiseMap[row][col] > blockedNoise)
+                {
+                    grid.setBlocked(col, row);
+                }
+            }
+        }
+    }
+
     void generateTiles(BatchRenderer *batchRenderer) {
+        // Texture variants are only visual, they must not shift the terrain stream
+        Pcg32& rng = rng_service.stream(RngStream::VISUALS);
         vec2 offset = {-w , -h / 2};
         for (int row = 0; row < numRows; row++)
         {
@@ -98,7 +120,7 @@ public:
                 if (noiseValue < 0.6)
                 {
                     // Grass area (60% chance)
-                    int randNum = rand() % 100;
+                    int randNum = rng.uniformInt(0, 99);
                     if (randNum < 40)
                         textureId = "grass1";
                     else if (randNum < 70)
@@ -115,7 +137,7 @@ public:
                 else
                 {
                     // Clay area (40% chance)
-                    int randNum = rand() % 100;
+                    int randNum = rng.uniformInt(0, 99);
                     if (randNum < 50)
                         textureId = "clay1";
                     else if (randNum < 75)
@@ -0,0 +1,26 @@
+#pragma once
+#include "isystems/IAssetManager.hpp"
+#include <memory>
+#include <unordered_map>
+
+/*
+    Asset manager of the headless build. Meshes keep their vertex and index data, without GL buffers,
+    for the collision system. Shaders, textures and fonts are only named, getting them returns nullptr.
+*/
+class NullAssetManager : public IAssetManager {
+public:
+    AssetId loadMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<uint32_t>& indices, const std::vector<VertexAttribute>& attributes) override;
+    AssetId loadParticleMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<uint32_t>& indices) override;
+    AssetId loadTexture(const std::string& name, const std::string& path) override;
+    AssetId loadBackgroundTexture(const std::string& name, const std::string& path) override;
+    AssetId loadShader(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath) override;
+    AssetId createMaterial(const std::string& name, const AssetId& shader, const AssetId& texture = "") override;
+    AssetId loadFont(const std::string& name, const std::string& path, float size) override;
+    Shader* getShader(const AssetId& name) override;
+    Mesh* getMesh(const AssetId& name) override;
+    Texture* getTexture(const AssetId& name) override;
+    Font* getFont(const AssetId& name) override;
+
+private:
+    std::unordered_map<AssetId, std::shared_ptr<Mesh>> meshes;
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include "isystems/IRenderSystem.hpp"
+#include "isystems/IAssetManager.hpp"
+#include "isystems/ISubRenderer.hpp"
+#include <map>
+
+/*
+    Renderer of the headless build: no window and no GL context, every draw call does nothing.
+    Meshes are still served from the asset manager since collisions test against their vertices.
+*/
+class NullRenderSystem final : public IRenderSystem {
+public:
+    bool initialize(IInputHandler&, int, int, const char*) override { return true; }
+    void setUpView() const override {}
+    void initializeCamera() override {}
+    void drawFrame(float, float) override {}
+    GLFWwindow* getGLWindow() const override { return nullptr; }
+    bool shouldClose() const override { return false; }
+
+    void getFramebufferSize(int& width, int& height) const override {
+        width = window_width_px;
+        height = window_height_px;
+    }
+
+    void buildTileLayer(TileGenerator&) override {}
+
+    void drawText(const std::string&, const std::string&, float, float, float, const glm::vec3&, bool) override {}
+    float getTextWidth(const std::string&, const std::string&, float) override { return 0.f; }
+    void drawParticles() override {}
+
+    void setAssetManager(IAssetManager* asset_manager) override {
+        this->asset_manager = asset_manager;
+    }
+
+    Mesh* getMesh(const AssetId& name) override {
+        return asset_manager->getMesh(name);
+    }
+
+    IAssetManager& getAssetManager() override {
+        return *asset_manager;
+    }
+
+    glm::mat4 getProjectionMatrix() override { return glm::mat4(1.f); }
+    glm::mat4 getViewMatrix() override { return glm::mat4(1.f); }
+    void updateRenderOrder(ComponentContainer<RenderRequest>&) override {}
+
+    void addSubRenderer(const std::string& name, ISubRenderer* sub_renderer) override {
+        sub_renderers[name] = sub_renderer;
+    }
+
+    void removeSubRenderer(const std::string& name) override {
+        sub_renderers.erase(name);
+    }
+
+    std::map<std::string, ISubRenderer*>& getSubRenderersMap() override {
+        return sub_renderers;
+    }
+
+    bool playVideo(const std::string&) override { return false; }
+    void stopVideo() override {}
+    void updateVideo() override {}
+    bool isPlayingVideo() const override { return false; }
+    // There is no video to wait for, the game goes on as if it had ended
+    void playCutscene(const std::string&, Song) override {
+        globalOptions.pause = false;
+        globalOptions.introPlayed = true;
+    }
+
+private:
+    IAssetManager* asset_manager = nullptr;
+    std::map<std::string, ISubRenderer*> sub_renderers;
+};
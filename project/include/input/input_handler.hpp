@@ -4,6 +4,7 @@
 #include "core/common.hpp"
 #include "entities/ecs_registry.hpp"
 #include "utils/spell_factory.hpp"
+#include "utils/replay.hpp"
 
 #include "isystems/IInputHandler.hpp"
 
@@ -15,18 +16,24 @@ public:
 
 	void onMouseMove(vec2 mouse_position);
 
-	void onMouseKey(GLFWwindow* window, int button, int action, int mods);
+	void onMouseMoveWorld(vec2 world_position);
+
+	void onMouseKey(int button, int action, int mods);
 
 	void reset();
 
 	void setRenderer(IRenderSystem* renderer) override;
 
+	// Every event received from now on is also written to recorder, nullptr to stop
+	void setRecorder(ReplayRecorder* recorder);
+
 private:
 	// keeps track of pressed movement keys (up, right, left, down) 
 	std::unordered_set<int> activeMoveKeys;
 	vec2 worldMousePosition;
 
 	IRenderSystem* renderer;
+	ReplayRecorder* recorder = nullptr;
 
 	void updateVelocity();
 	void cast_player_spell(double x, double y, bool is_left);
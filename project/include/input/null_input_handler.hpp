@@ -0,0 +1,13 @@
+#pragma once
+#include "isystems/IInputHandler.hpp"
+
+// Ignores every event, given to the window while a replay drives the real input handler
+class NullInputHandler final : public IInputHandler {
+public:
+    void onKey(int, int, int, int) override {}
+    void onMouseMove(vec2) override {}
+    void onMouseMoveWorld(vec2) override {}
+    void onMouseKey(int, int, int) override {}
+    void reset() override {}
+    void setRenderer(IRenderSystem*) override {}
+};
@@ -13,10 +13,13 @@ public:
         int action,
         int mods) = 0;
 
+    // Cursor in window coordinates
     virtual void onMouseMove(vec2 mouse_position) = 0;
+    // Cursor already in world coordinates, as replays feed it back
+    virtual void onMouseMoveWorld(vec2 world_position) = 0;
 
+    // Acts at the last cursor position, the window sends it with onMouseMove first
     virtual void onMouseKey(
-        GLFWwindow* window,
         int button,
         int action,
         int mods) = 0;
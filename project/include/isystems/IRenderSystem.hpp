@@ -16,8 +16,13 @@ public:
                             const char *title = "OpenGL Example") = 0;
     virtual void setUpView() const = 0;
     virtual void initializeCamera() = 0;
-    virtual void drawFrame(float elapsed_ms) = 0;
+    // alpha: how far rendering is between the last two simulation ticks (0 to 1)
+    virtual void drawFrame(float elapsed_ms, float alpha) = 0;
     virtual GLFWwindow *getGLWindow() const = 0;
+    virtual bool shouldClose() const = 0;
+    virtual void getFramebufferSize(int &width, int &height) const = 0;
+    // Replace the background tile layer with the tiles of tile_generator
+    virtual void buildTileLayer(TileGenerator &tile_generator) = 0;
     virtual void drawText(const std::string &text,
                           const std::string &fontName,
                           float x, float y,
@@ -14,4 +14,5 @@ class AudioSystem;
 class IAssetManager;
 class IInputHandler;
 class IRenderSystem;
-class ISubRenderer;
\ No newline at end of file
+class ISubRenderer;
+class TileGenerator;
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+#include "entities/ecs_registry.hpp"
+
+// Give an entity the collision layer and mask of its role (player, enemy, projectile, interactable).
+// Call once its components are in place; entities without any of those roles get no layer and never collide.
+void assignCollisionLayer(ECSRegistry& registry, Entity entity);
@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+// Value of a --name=value argument, or nullptr if arg is not one
+const char* argumentValue(const std::string& arg, const std::string& name);
+
+// Apply a startup option of the simulation, e.g. --broadphase=sap --tick-rate=30 --seed=42 --hash-log=run.hashes.
+// Shared by the game and the headless runner, returns false if arg is not one of them.
+bool parseSimulationArgument(const std::string& arg);
@@ -27,8 +27,26 @@ const float ENEMY_INVINCIBILITY_TIMER = 800.f;
 const float PLAYER_INVINCIBILITY_TIMER = 1500.f;
 
 const int MAX_PARTICLES = 10000;
+
+// Fixed timestep, see --tick-rate and --max-steps
+const int DEFAULT_TICK_RATE = 60;
+const int DEFAULT_MAX_STEPS_PER_FRAME = 5;
 const float START_WORLD_TIME = 10 * 60000.f + 1000; // 10 minutes, plus a bit for showing 10 on the clock
 
+// --- Collision ---
+// Selected at startup with --broadphase=grid|sap
+enum class BroadphaseType
+{
+    GRID,           // uniform spatial hash
+    SWEEP_AND_PRUNE // persistent sorted x-axis endpoints
+};
+
+const float BROADPHASE_CELL_SIZE = 64.f;
+
+// Terrain blocking movement, one occupancy cell per background tile.
+// Tiles whose smoothed noise is above this block movement. Above every noise value until blocking tile art exists.
+const float TERRAIN_BLOCKED_NOISE = 1.f;
+
 // --- Damage Types ---
 enum class DamageType
 {
@@ -154,6 +172,7 @@ const float LIGHTNING_ACTIVE_LIFETIME = 250.f; // Lightning bolt lasts 0.25 seco
 const int MAX_LIGHTNING_ATTACK_COUNT = 4;
 const vec2 MAX_LIGHTNING_DELAY_DIFFERENCE = { 100.f, 400.f };
 const vec2 MAX_LIGHTNING_POS_DIFFERENCE = { -50.f, 50.f };
+const float MAX_LIGHTNING_CHAIN_RADIUS = 300.f; // Chained bolts strike the closest enemies within this distance
 const float MAX_LIGHTNING_DAMAGE = 7.f;
 const float LIGHTNING_SCALING[4] = { 1.0, 1.1, 1.3, 1.4 };
 
@@ -200,6 +219,7 @@ enum class EnemyType
 
 // --- Enemy Constants ---
 const float ENEMY_BASIC_RANGE = 100.f;
+const float ENEMY_OBSTACLE_LOOKAHEAD = 48.f; // Chasing enemies turn before walking into terrain this close
 const float INIT_ENEMY_HEALTH_SCALE = 1.f;
 const float ENEMY_HEALTH_SCALING_INCREMENT = 0.00015f;
 
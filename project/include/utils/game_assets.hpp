@@ -1,7 +1,7 @@
 // GameAssets.hpp
 #pragma once
 
-#include "graphics/asset_manager.hpp"
+#include "isystems/IAssetManager.hpp"
 #include <unordered_map>
 #include <string>
 #include <chrono>
@@ -16,4 +16,4 @@ struct GameAssets {
 };
 
 // Function to initialize all game assets
-GameAssets initializeGameAssets(AssetManager& assetManager);
+GameAssets initializeGameAssets(IAssetManager& assetManager);
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/*
+    Wall-clock time spent in each system of the simulation step, summed over ticks.
+    Disabled by default, measure() then only runs the work. Sections are reported in the order first measured.
+*/
+class Profiler
+{
+public:
+    bool enabled = false;
+
+    template <typename Work>
+    void measure(const char* section, Work&& work)
+    {
+        if (!enabled)
+        {
+            work();
+            return;
+        }
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        work();
+        const auto end = std::chrono::high_resolution_clock::now();
+        record(section, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    // Count one simulation tick
+    void tick() { ticks++; }
+    void reset();
+    // Print ticks/sec over wall_seconds and the average time of each section per tick
+    void report(FILE* out, double wall_seconds) const;
+
+private:
+    struct Section
+    {
+        const char* name;
+        double total_ms;
+    };
+
+    std::vector<Section> sections;
+    unsigned long long ticks = 0;
+
+    void record(const char* section, double elapsed_ms);
+};
+
+// Distribution of frame or tick times, e.g. over a replay
+class FrameTimes
+{
+public:
+    void add(double elapsed_ms) { samples.push_back(elapsed_ms); }
+    void clear() { samples.clear(); }
+    // Print count, mean, min, percentiles and max of the samples
+    void report(FILE* out, const char* name) const;
+
+private:
+    std::vector<double> samples;
+};
+
+extern Profiler profiler;
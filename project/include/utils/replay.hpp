@@ -0,0 +1,74 @@
+#pragma once
+#include "core/common.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+class IInputHandler;
+
+/*
+    Replay file: a header with what the simulation was started with, then a stream of records.
+    Input events come before the tick they were applied to, runs of ticks of the same length share one record.
+    Fields are written in host byte order.
+
+    header:       "SLRP", u32 version, u64 seed, u32 tick rate, u8 broadphase, u8 starts on the tutorial
+    TICKS:        u8 type, u32 count, f32 elapsed_ms
+    KEY:          u8 type, i16 key, i16 scancode, u8 action, u8 mods
+    MOUSE_MOVE:   u8 type, f32 world x, f32 world y
+    MOUSE_BUTTON: u8 type, u8 button, u8 action, u8 mods
+*/
+enum class ReplayRecord : uint8_t
+{
+    TICKS = 0,
+    KEY = 1,
+    MOUSE_MOVE = 2,
+    MOUSE_BUTTON = 3,
+};
+
+// Writes the input of a session and the ticks it ran, see --record
+class ReplayRecorder
+{
+public:
+    ~ReplayRecorder();
+
+    // Starts the file with the current seed, tick rate, broadphase and tutorial state, so open it after those are set
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void key(int key, int scancode, int action, int mods);
+    // The cursor in world coordinates, which does not depend on the camera or window size
+    void mouseMove(vec2 world_position);
+    void mouseButton(int button, int action, int mods);
+    // A simulation step of elapsed_ms, after the events it saw
+    void tick(float elapsed_ms);
+
+private:
+    FILE* file = nullptr;
+    uint32_t pending_ticks = 0;
+    float pending_elapsed_ms = 0.f;
+
+    void flushTicks();
+};
+
+// Reads back a file of ReplayRecorder, see --replay
+class ReplayPlayer
+{
+public:
+    ~ReplayPlayer();
+
+    // Also restores the seed, tick rate, broadphase and tutorial state of the recording, so open it before the world is initialized
+    bool open(const std::string& path);
+    void close();
+
+    // Sends the events recorded before the next tick to input and returns the length of that tick.
+    // Returns false once the recording is over.
+    bool nextTick(IInputHandler& input, float& elapsed_ms);
+    unsigned long long getTicks() const { return ticks; }
+
+private:
+    FILE* file = nullptr;
+    uint32_t pending_ticks = 0;
+    float pending_elapsed_ms = 0.f;
+    unsigned long long ticks = 0;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+
+// Systems drawing random numbers, each from its own stream so draws in one never shift another
+enum class RngStream
+{
+    ENEMY_SPAWNS,
+    COLLECTIBLES,
+    SPELLS,
+    SPELL_QUEUE,
+    TERRAIN,
+    VISUALS, // never affects the simulation: rain, particles, tile variants
+    COUNT
+};
+
+// PCG32 (pcg-random.org): 64 bits of state, 32 bit outputs, one of 2^63 streams picked at seeding
+class Pcg32
+{
+public:
+    using result_type = uint32_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    void seed(uint64_t state_seed, uint64_t stream);
+    result_type operator()();
+
+    // Uniform in [min, max)
+    float uniform(float min, float max);
+    // Uniform in [min, max], both inclusive
+    int uniformInt(int min, int max);
+
+private:
+    uint64_t state = 0;
+    uint64_t increment = 1;
+};
+
+/*
+    Every random number of the game comes from here. All streams derive from one master seed,
+    random by default and set with --seed, so a run can be reproduced exactly.
+*/
+class RngService
+{
+public:
+    RngService();
+
+    void seed(uint64_t master_seed);
+    uint64_t getSeed() const { return master_seed; }
+
+    Pcg32& stream(RngStream stream) { return streams[(int)stream]; }
+
+private:
+    uint64_t master_seed = 0;
+    Pcg32 streams[(int)RngStream::COUNT];
+};
+
+extern RngService rng_service;
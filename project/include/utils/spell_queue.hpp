@@ -1,6 +1,5 @@
 #pragma once
 
-#include <random>
 #include <deque>
 #include <unordered_map>
 #include <utils/constants.hpp>
@@ -34,6 +33,10 @@ public:
 	void setLeftSpell(SpellType spell) { firstSpell = spell; }
 	void setRightSpell(SpellType spell) { secondSpell = spell; }
 
+	// Read only views, unlike getSpellLevel and getSpellUpgradeTrack these never add entries
+	const std::unordered_map<SpellType, int, SpellTypeHash>& getSpellLevels() const { return collectedSpells; }
+	const std::unordered_map<SpellType, int, SpellTypeHash>& getUpgradeTracks() const { return upgradeTracker; }
+
 	void levelSpell(SpellType spell);
 	const std::vector<std::pair<SpellType, int>> getCollectedSpells();
 	const int getSpellLevel(SpellType spell);
@@ -51,7 +54,6 @@ private:
 
 	std::deque<SpellType> queue;
 	std::unordered_map<SpellType, int, SpellTypeHash> collectedSpells;
-	std::mt19937 rng;
 
 	std::unordered_map<SpellType, int, SpellTypeHash> upgradeTracker;
 };
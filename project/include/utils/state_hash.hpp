@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Gameplay components covered by the state hash, in the order they are logged
+enum class HashedComponent
+{
+    MOTION,
+    HEALTH,
+    ENEMY,
+    PROJECTILE,
+    SPELL_STATE,
+    SPELL_QUEUE,
+    COUNT
+};
+
+const char* hashedComponentName(HashedComponent component);
+
+/*
+    64 bit hash of the gameplay state after a tick, one per component and their combination.
+    Each entity is hashed on its own and the results summed, so neither the order of a container nor
+    entity ids affect it. Floats are hashed bit for bit, any change in the simulation shows.
+*/
+struct StateHash
+{
+    uint64_t total = 0;
+    uint64_t components[(int)HashedComponent::COUNT] = {};
+
+    bool operator==(const StateHash& other) const;
+    bool operator!=(const StateHash& other) const { return !(*this == other); }
+};
+
+StateHash computeStateHash();
+
+/*
+    Text log of the state hash after every simulated tick, see --hash-log.
+    Two logs of the same replay or seed are compared with soulless_headless --compare-hashes.
+*/
+class StateHashLog
+{
+public:
+    ~StateHashLog();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Hash the current state as the next tick
+    void record();
+
+    // Print the first tick where the logs differ with a breakdown per component.
+    // Returns true if they match over every tick both have.
+    static bool compare(const std::string& path_a, const std::string& path_b, FILE* out);
+
+private:
+    FILE* file = nullptr;
+    unsigned long long ticks = 0;
+};
+
+extern StateHashLog state_hash_log;
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    Fixed set of worker threads for data-parallel loops.
+    parallel_for splits a range into chunks that the workers and the calling thread pull until none are left,
+    and only returns once every chunk ran. Tasks must not touch shared state without their own synchronisation.
+*/
+class ThreadPool
+{
+public:
+    // One worker per hardware thread besides the calling one
+    static unsigned int default_worker_count();
+
+    explicit ThreadPool(unsigned int worker_count = default_worker_count());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int size() const { return (unsigned int)workers.size(); }
+
+    // Calls task(begin, end) over [0, count) in chunks of at most grain items
+    void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& task);
+
+private:
+    void worker_loop();
+    void run_chunks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+
+    // Current job, published under the mutex
+    const std::function<void(size_t, size_t)>* task = nullptr;
+    size_t task_count = 0;
+    size_t task_grain = 1;
+    std::atomic<size_t> next_chunk{ 0 };
+    unsigned int job_id = 0;
+    unsigned int busy_workers = 0;
+    bool stopping = false;
+};
@@ -1,6 +1,8 @@
 #include "ai/ai_system.hpp"
 #include "entities/ecs_registry.hpp"
 #include "utils/angle_functions.hpp"
+#include "utils/collision_layers.hpp"
+#include "core/occupancy_grid.hpp"
 
 #include "sound/sound_manager.hpp"
 
@@ -309,6 +311,9 @@ AIComponent& AI_SYSTEM::initAIComponent(Entity* entity) {
 
 
             vec2 direction_normalized = glm::normalize(player_motion.position - motion.position);
+
+            direction_normalized = occupancy_grid.steerAround(motion.position, direction_normalized, ENEMY_OBSTACLE_LOOKAHEAD);
+
             motion.velocity = direction_normalized * speed;
             return NodeState::SUCCESS;
         },
@@ -342,12 +347,20 @@ void AI_SYSTEM::slash(const Entity& enemy_ent) {
 }
 
 void AI_SYSTEM::tickForEntity(Entity* entity, float elapsed_ms) {
+    // Behaviour tree lambdas capture this handle, never tick on a released entity
+    if (!registry.valid(*entity)) {
+        return;
+    }
     if (!registry.enemies.has(*entity)) {
         return;
     }
     if (!registry.ai_systems.has(*entity)) {
         return;
     }
+    // A killed enemy keeps its AI component until the commands of the tick are flushed
+    if (registry.deaths.has(*entity)) {
+        return;
+    }
     auto& aiComponent = registry.ai_systems.get(*entity);
     if (aiComponent.root) {
         aiComponent.root->tick(elapsed_ms);
@@ -356,7 +369,7 @@ void AI_SYSTEM::tickForEntity(Entity* entity, float elapsed_ms) {
 
 void AI_SYSTEM::create_enemy_projectile(const Entity& enemy_ent, bool mainSpell)
 {
-    Entity projectile_ent;
+    Entity projectile_ent = Entity::create();
     Projectile& projectile = registry.projectiles.emplace(projectile_ent);
     Motion& projectile_motion = registry.motions.emplace(projectile_ent);
     Deadly& deadly = registry.deadlies.emplace(projectile_ent);
@@ -380,6 +393,7 @@ void AI_SYSTEM::create_enemy_projectile(const Entity& enemy_ent, bool mainSpell)
     projectile.type = DamageType::elementless;
     projectile.range = enemy.range;
     projectile.isActive = true;
+    assignCollisionLayer(registry, projectile_ent);
 
     float attack_velocity;
     float attack_damage;
@@ -408,6 +422,7 @@ void AI_SYSTEM::create_enemy_projectile(const Entity& enemy_ent, bool mainSpell)
             projectile_motion.scale = { 0.75f, 0.75f };
             projectile_motion.collider = { 37.5f, 37.5f };
             projectile.type = DamageType::plasma;
+            registry.sweptColliders.emplace(projectile_ent).start_position = projectile_motion.position;
         } else {
             Entity player = registry.players.entities[0];
             Motion &motionPlayer = registry.motions.get(player);
@@ -0,0 +1,91 @@
+#include "core/aabb_batch.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AABB_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+void AabbBatch::clear()
+{
+    min_x.clear();
+    min_y.clear();
+    max_x.clear();
+    max_y.clear();
+}
+
+void AabbBatch::push_back(const vec2& min, const vec2& max)
+{
+    min_x.push_back(min.x);
+    min_y.push_back(min.y);
+    max_x.push_back(max.x);
+    max_y.push_back(max.y);
+}
+
+void AabbBatch::swap_pop(size_t i)
+{
+    min_x[i] = min_x.back();
+    min_y[i] = min_y.back();
+    max_x[i] = max_x.back();
+    max_y[i] = max_y.back();
+    min_x.pop_back();
+    min_y.pop_back();
+    max_x.pop_back();
+    max_y.pop_back();
+}
+
+size_t AabbBatch::overlap_mask(const vec2& min, const vec2& max, std::vector<unsigned char>& hits) const
+{
+    const size_t count = size();
+    hits.resize(count);
+    size_t hit_count = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256 query_min_x = _mm256_set1_ps(min.x);
+    const __m256 query_min_y = _mm256_set1_ps(min.y);
+    const __m256 query_max_x = _mm256_set1_ps(max.x);
+    const __m256 query_max_y = _mm256_set1_ps(max.y);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 hit = _mm256_cmp_ps(_mm256_loadu_ps(&min_x[i]), query_max_x, _CMP_LE_OQ);
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(query_min_x, _mm256_loadu_ps(&max_x[i]), _CMP_LE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(&min_y[i]), query_max_y, _CMP_LE_OQ));
+        hit = _mm256_and_ps(hit, _mm256_cmp_ps(query_min_y, _mm256_loadu_ps(&max_y[i]), _CMP_LE_OQ));
+        const int mask = _mm256_movemask_ps(hit);
+        for (int k = 0; k < 8; k++)
+        {
+            hits[i + k] = (mask >> k) & 1;
+            hit_count += (mask >> k) & 1;
+        }
+    }
+#elif defined(AABB_BATCH_SSE2)
+    const __m128 query_min_x = _mm_set1_ps(min.x);
+    const __m128 query_min_y = _mm_set1_ps(min.y);
+    const __m128 query_max_x = _mm_set1_ps(max.x);
+    const __m128 query_max_y = _mm_set1_ps(max.y);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 hit = _mm_cmple_ps(_mm_loadu_ps(&min_x[i]), query_max_x);
+        hit = _mm_and_ps(hit, _mm_cmple_ps(query_min_x, _mm_loadu_ps(&max_x[i])));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_loadu_ps(&min_y[i]), query_max_y));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(query_min_y, _mm_loadu_ps(&max_y[i])));
+        const int mask = _mm_movemask_ps(hit);
+        for (int k = 0; k < 4; k++)
+        {
+            hits[i + k] = (mask >> k) & 1;
+            hit_count += (mask >> k) & 1;
+        }
+    }
+#endif
+
+    // Scalar fallback and the tail of the vector loop
+    for (; i < count; i++)
+    {
+        const bool hit = min_x[i] <= max.x && min.x <= max_x[i] && min_y[i] <= max.y && min.y <= max_y[i];
+        hits[i] = hit ? 1 : 0;
+        hit_count += hit ? 1 : 0;
+    }
+    return hit_count;
+}
@@ -0,0 +1,137 @@
+#include "core/collider_cache.hpp"
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+
+void ColliderCache::load(const AssetId& name, const Mesh& mesh)
+{
+    ColliderShape& shape = shapes[name];
+    shape.triangle_count = (int)(mesh.indices.size() / 3);
+    assert(shape.triangle_count <= ColliderShape::MAX_TRIANGLES && "Collider mesh has too many triangles");
+    shape.triangle_count = std::min(shape.triangle_count, (int)ColliderShape::MAX_TRIANGLES);
+
+    // Vertices are 3 floats each, z is unused
+    for (int t = 0; t < shape.triangle_count; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const uint32_t vertex = mesh.indices[t * 3 + k];
+            shape.vertices[t][k] = { mesh.vertices[vertex * 3], mesh.vertices[vertex * 3 + 1] };
+        }
+        for (int k = 0; k < 3; k++)
+        {
+            const vec2 edge = shape.vertices[t][(k + 1) % 3] - shape.vertices[t][k];
+            shape.normals[t][k] = { -edge.y, edge.x };
+        }
+    }
+}
+
+bool ColliderCache::has(const AssetId& name) const
+{
+    return shapes.find(name) != shapes.end();
+}
+
+void ColliderCache::next_tick()
+{
+    tick++;
+}
+
+const TransformedCollider& ColliderCache::get(const Entity& entity, const AssetId& name, const Motion& motion)
+{
+    Entry* entry = nullptr;
+    Entry* stale = nullptr;
+    for (Entry& candidate : entries)
+    {
+        if (candidate.entity == entity)
+        {
+            entry = &candidate;
+            break;
+        }
+        if (candidate.tick != tick) stale = &candidate;
+    }
+
+    if (entry && entry->tick == tick) return entry->collider;
+
+    if (!entry)
+    {
+        // Re-use the slot of an entity that was not checked this tick
+        if (stale)
+        {
+            entry = stale;
+            entry->entity = entity;
+        }
+        else
+        {
+            entries.push_back({ entity, 0, {} });
+            entry = &entries.back();
+        }
+    }
+
+    const auto shape_it = shapes.find(name);
+    assert(shape_it != shapes.end() && "Collider shape was not loaded");
+    const ColliderShape& shape = shape_it->second;
+    TransformedCollider& collider = entry->collider;
+
+    // Same as translating by position and scaling by half the collider. Edge normals of a scaled
+    // triangle are the local normals scaled by the swapped axes.
+    const vec2 half = motion.collider / 2.f;
+    const vec2 normal_scale = { half.y, half.x };
+    collider.triangle_count = shape.triangle_count;
+    collider.min = vec2(INFINITY);
+    collider.max = vec2(-INFINITY);
+    for (int t = 0; t < shape.triangle_count; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            const vec2 vertex = motion.position + shape.vertices[t][k] * half;
+            collider.vertices[t][k] = vertex;
+            collider.normals[t][k] = shape.normals[t][k] * normal_scale;
+            collider.min = glm::min(collider.min, vertex);
+            collider.max = glm::max(collider.max, vertex);
+        }
+    }
+    entry->tick = tick;
+    return collider;
+}
+
+const TransformedCollider& ColliderCache::lookup(const Entity& entity) const
+{
+    for (const Entry& entry : entries)
+    {
+        if (entry.entity == entity)
+        {
+            assert(entry.tick == tick && "Collider was not transformed this tick");
+            return entry.collider;
+        }
+    }
+    assert(false && "Collider was never transformed");
+    return empty;
+}
+
+bool triangle_overlaps_box(const vec2 (&triangle)[3], const vec2 (&normals)[3], const vec2& box_min, const vec2& box_max)
+{
+    // Box axes first, they are the triangle's bounding box against the box
+    const vec2 triangle_min = glm::min(triangle[0], glm::min(triangle[1], triangle[2]));
+    const vec2 triangle_max = glm::max(triangle[0], glm::max(triangle[1], triangle[2]));
+    if (triangle_max.x < box_min.x || box_max.x < triangle_min.x || triangle_max.y < box_min.y || box_max.y < triangle_min.y)
+    {
+        return false;
+    }
+
+    const vec2 box_center = (box_min + box_max) / 2.f;
+    const vec2 box_half = (box_max - box_min) / 2.f;
+    for (int k = 0; k < 3; k++)
+    {
+        const vec2& normal = normals[k];
+        const float p0 = dot(triangle[0], normal);
+        const float p1 = dot(triangle[1], normal);
+        const float p2 = dot(triangle[2], normal);
+        const float center = dot(box_center, normal);
+        const float radius = std::abs(normal.x) * box_half.x + std::abs(normal.y) * box_half.y;
+        if (std::max(p0, std::max(p1, p2)) < center - radius || center + radius < std::min(p0, std::min(p1, p2)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -2,42 +2,57 @@
 #include "entities/ecs_registry.hpp"
 #include "utils/spell_factory.hpp"
 #include "sound/sound_manager.hpp"
+#include "core/spatial_hash.hpp"
+#include "core/sweep_and_prune.hpp"
+#include "core/spatial_index.hpp"
 #include <glm/ext/matrix_clip_space.hpp>
 #include <random>
 
+// Upper bound of the steps a fast entity is split into against mesh colliders
+static const int MAX_SWEEP_STEPS = 16;
+// Narrowphase batches smaller than this are not worth handing to the worker threads
+static const size_t PARALLEL_NARROWPHASE_MIN_CONTACTS = 64;
+static const size_t PARALLEL_NARROWPHASE_GRAIN = 16;
+
 CollisionSystem::CollisionSystem(IRenderSystem* renderer)
 {
     this->renderer = renderer;
-}
 
-void CollisionSystem::init()
-{
+    switch (globalOptions.broadphase)
+    {
+    case BroadphaseType::SWEEP_AND_PRUNE:
+        broadphase = std::make_unique<SweepAndPrune>();
+        break;
+    case BroadphaseType::GRID:
+    default:
+    {
+        // Neighbour queries read the grid built for the pairs instead of bucketing every collider again
+        std::unique_ptr<SpatialHash> grid = std::make_unique<SpatialHash>(BROADPHASE_CELL_SIZE);
+        spatial_index.share_broadphase(grid.get());
+        broadphase = std::move(grid);
+        break;
+    }
+    }
+
+    // Handlers run in category order
+    register_handler(CollisionCategory::PROJECTILE_PLAYER, &CollisionSystem::resolve_projectile_player, &CollisionSystem::mesh_contact);
+    register_handler(CollisionCategory::PROJECTILE_ENEMY, &CollisionSystem::resolve_projectile_enemy);
+    register_handler(CollisionCategory::ENEMY_PLAYER, &CollisionSystem::resolve_enemy_player, &CollisionSystem::mesh_contact);
+    register_handler(CollisionCategory::INTERACTABLE_PLAYER, &CollisionSystem::resolve_interactable_player, &CollisionSystem::pickup_contact);
 }
 
-static std::vector<vec2> get_corners(const Entity& entity)
+CollisionSystem::~CollisionSystem()
 {
-    const Motion& motion = registry.motions.get(entity);
-    vec2 bounding_box = motion.collider / 2.f;
-    return std::vector<vec2>({
-        { motion.position - bounding_box },
-        { motion.position + vec2({ bounding_box.x, -bounding_box.y })},
-        { motion.position + vec2({ -bounding_box.x, bounding_box.y })},
-        { motion.position + bounding_box }
-        });
+    spatial_index.share_broadphase(nullptr);
 }
 
-static bool check_collision(const Entity& entity, const Entity& other_entity)
+// Extract the shapes of the loaded mesh colliders, anything added later is loaded on first use
+void CollisionSystem::init()
 {
-    Motion& motion = registry.motions.get(entity);
-    Motion& other_motion = registry.motions.get(other_entity);
-
-    vec2 bounding_box = motion.collider / 2.f;
-    vec2 other_bounding_box = other_motion.collider / 2.f; // Its x and y means width and height
-
-    return (
-        std::abs(motion.position.x - other_motion.position.x) <= bounding_box.x + other_bounding_box.x
-        && std::abs(motion.position.y - other_motion.position.y) <= bounding_box.y + other_bounding_box.y
-        );
+    for (const MeshCollider& collider : registry.mesh_colliders.components)
+    {
+        if (!collider_cache.has(collider.mesh)) collider_cache.load(collider.mesh, *renderer->getMesh(collider.mesh));
+    }
 }
 
 static mat4 create_transform(const Motion& motion, bool do_rotate = false)
@@ -62,7 +77,7 @@ static void draw_debug(const vec2& vertex, const vec2& other_vertex, vec3 color
     vec2 diff = other_vertex - vertex;
     float angle = std::atan2(diff.y, diff.x) + M_PI / 2.f;
 
-    Entity new_debug;
+    Entity new_debug = Entity::create();
     DebugRequest& vertex_debug = registry.debug_requests.emplace(new_debug);
     vertex_debug.collider = line_len;
     vertex_debug.position = line_pos;
@@ -74,7 +89,7 @@ static void draw_debug(const vec2& vertex, const vec2& other_vertex, vec3 color
 static void draw_bounding_box(const Entity& entity, const vec3 color = { 1.f, 0.f, 0.f })
 {
     Motion& motion = registry.motions.get(entity);
-    const Entity box_entity;
+    const Entity box_entity = Entity::create();
     DebugRequest& debug = registry.debug_requests.emplace(box_entity);
     debug.position = motion.position;
     debug.collider = motion.collider / 2.f;
@@ -88,7 +103,7 @@ static void draw_vertices(const Entity& entity, const Mesh& mesh)
 
     for (int i = 0; i < mesh.vertices.size(); i += 3)
     {
-        Entity vertex_ent;
+        Entity vertex_ent = Entity::create();
         DebugRequest& vertex_debug = registry.debug_requests.emplace(vertex_ent);
         vertex_debug.collider = { 1, 1 };
         vertex_debug.type = DebugType::fill;
@@ -96,84 +111,101 @@ static void draw_vertices(const Entity& entity, const Mesh& mesh)
     }
 }
 
-static float get_normal_point(const vec2& point, const vec2& normal)
-{
-    return dot(point, normal) / length(normal);
-}
-
-static vec2 project_to_normal(const std::vector<vec2>& vertices, const vec2& normal)
+// Slab test of the segment start -> end against a box.
+// Returns the time of impact in [0, 1], or -1 if the segment misses the box.
+static float segment_box_time_of_impact(const vec2& start, const vec2& end, const vec2& box_min, const vec2& box_max)
 {
-    float min = INFINITY;
-    float max = -INFINITY;
-    float project_val;
-
-    for (const vec2& vertex : vertices)
+    const vec2 delta = end - start;
+    float t_enter = 0.f;
+    float t_exit = 1.f;
+    for (int axis = 0; axis < 2; axis++)
     {
-        project_val = get_normal_point(vertex, normal);
-        if (project_val > max) max = project_val;
-        if (project_val < min) min = project_val;
-    }
+        if (std::abs(delta[axis]) < 1e-8f)
+        {
+            if (start[axis] < box_min[axis] || start[axis] > box_max[axis]) return -1.f;
+            continue;
+        }
 
-    return { min, max };
+        float t0 = (box_min[axis] - start[axis]) / delta[axis];
+        float t1 = (box_max[axis] - start[axis]) / delta[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        t_enter = std::max(t_enter, t0);
+        t_exit = std::min(t_exit, t1);
+        if (t_enter > t_exit) return -1.f;
+    }
+    return t_enter;
 }
 
-// specifically triangle to rectangle check
-static bool check_overlap(const std::vector<vec2>& vertices, const std::vector<vec2>& corners)
+static vec2 start_position_of(const Entity& entity, const Motion& motion)
 {
-    std::vector<vec2> normals;
-    for (int i = 0; i < vertices.size(); i++)
-    {
-        vec2 edge = vertices[(i + 1) % vertices.size()] - vertices[i];
-        normals.push_back({ -edge.y, edge.x });
-    }
-    normals.push_back({ 1, 0 });
-    normals.push_back({ 0, 1 });
+    return registry.sweptColliders.has(entity) ? registry.sweptColliders.get(entity).start_position : motion.position;
+}
 
-    for (const vec2& normal : normals)
-    {
-        vec2 triangle_min_max = project_to_normal(vertices, normal);
-        vec2 rect_min_max = project_to_normal(corners, normal);
-        if (triangle_min_max[1] < rect_min_max[0] || rect_min_max[1] < triangle_min_max[0])
-        {
-            return false;
-        }
-    }
-    return true;
+// Whether the boxes of two entities touch at any time of this tick, assuming both moved in a straight line.
+// Relative to the other entity the box becomes a point on a segment, and the other box grows by its half extents.
+static bool sweeps_overlap(const Entity& entity, const Entity& other_entity)
+{
+    const Motion& motion = registry.motions.get(entity);
+    const Motion& other_motion = registry.motions.get(other_entity);
+    const vec2 half = glm::abs(motion.collider / 2.f) + glm::abs(other_motion.collider / 2.f);
+    const vec2 start = start_position_of(entity, motion) - start_position_of(other_entity, other_motion);
+    const vec2 end = motion.position - other_motion.position;
+    return segment_box_time_of_impact(start, end, -half, half) >= 0.f;
 }
 
 void CollisionSystem::detect_collisions()
 {
-    std::unordered_set<Entity> visited;
-    for (const Entity& entity : registry.motions.entities)
+    collider_cache.next_tick();
+    ComponentContainer<Motion>& motions = registry.motions;
+
+    broadphase->clear();
+    for (unsigned int i = 0; i < motions.size(); i++)
     {
-        if (registry.deaths.has(entity)) {
-            visited.insert(entity);
-            continue;
-        }
+        const Entity& entity = motions.entities[i];
+        if (registry.deaths.has(entity)) continue;
 
         if (registry.players.has(entity) && registry.debug)
         {
             draw_vertices(entity, *renderer->getMesh("mage_collider")); // can fetch mesh from component as well
         }
 
-        for (const Entity& other_entity : registry.motions.entities)
+        // Entities without a collision layer have nothing to interact with
+        if (!registry.collisionLayers.has(entity)) continue;
+
+        const Motion& motion = motions.components[i];
+        const CollisionLayer& layer = registry.collisionLayers.get(entity);
+        if (registry.sweptColliders.has(entity))
         {
-            if (entity == other_entity) continue;
-            if (visited.find(other_entity) != visited.end()) continue;
-            if (registry.deaths.has(other_entity)) continue;
-            if (check_collision(entity, other_entity))
-            {
-                registry.collision_registry.register_collision(entity, other_entity);
-            }
+            // The proxy covers the whole movement of this tick
+            const vec2 start = registry.sweptColliders.get(entity).start_position;
+            const vec2 half = glm::abs(motion.collider / 2.f) + glm::abs(motion.position - start) / 2.f;
+            broadphase->insert(entity, (start + motion.position) / 2.f, half, layer.layer, layer.mask);
+        }
+        else
+        {
+            broadphase->insert(entity, motion.position, motion.collider / 2.f, layer.layer, layer.mask);
+        }
+    }
+
+    candidate_pairs.clear();
+    broadphase->find_pairs(candidate_pairs);
+    for (const auto& pair : candidate_pairs)
+    {
+        // Swept proxies are loose, keep the pair only if the boxes met along the way
+        if ((registry.sweptColliders.has(pair.first) || registry.sweptColliders.has(pair.second))
+            && !sweeps_overlap(pair.first, pair.second))
+        {
+            continue;
         }
-        visited.insert(entity);
+        registry.collision_registry.register_collision(pair.first, pair.second);
     }
+    registry.collision_registry.finalize();
 
     if (registry.debug)
     {
         for (const Entity& entity : registry.motions.entities)
         {
-            if (registry.collision_registry.get_collision_by_ent(entity).size() > 0)
+            if (!registry.collision_registry.get_collision_by_ent(entity).empty())
             {
                 draw_bounding_box(entity, { 0.f, 1.f, 0.f });
             }
@@ -185,46 +217,66 @@ void CollisionSystem::detect_collisions()
     }
 }
 
-bool CollisionSystem::is_mesh_colliding(const Entity& primary, const Entity& other_entity)
+// Mesh collider against a box, bounds of the whole collider first
+static bool collider_overlaps_box(const TransformedCollider& collider, const vec2& box_min, const vec2& box_max)
 {
-    assert(registry.mesh_colliders.has(primary) && "Missing collider mesh for target");
-
-    const Motion& motion = registry.motions.get(primary);
-    const Mesh collision_mesh = *renderer->getMesh(registry.mesh_colliders.get(primary).mesh);
-
-    mat4 transform = create_transform(motion);
-    std::vector<vec2> vertices;
-
-    for (int i = 0; i < collision_mesh.vertices.size(); i += 3)
+    if (collider.max.x < box_min.x || box_max.x < collider.min.x || collider.max.y < box_min.y || box_max.y < collider.min.y)
     {
-        vertices.push_back({ collision_mesh.vertices[i], collision_mesh.vertices[i + 1] });
+        return false;
     }
 
     bool result = false;
-    for (int i = 0; i < collision_mesh.indices.size(); i += 3)
+    for (int i = 0; i < collider.triangle_count; i++)
     {
-        const vec2 vertex1 = transformed_vertex(vertices[collision_mesh.indices[i]], transform);
-        const vec2 vertex2 = transformed_vertex(vertices[collision_mesh.indices[i + 1]], transform);
-        const vec2 vertex3 = transformed_vertex(vertices[collision_mesh.indices[i + 2]], transform);
-        std::vector<vec2> triangle = std::vector<vec2>({ vertex1, vertex2, vertex3 });
-
-        if (check_overlap(triangle, get_corners(other_entity)))
+        const vec2 (&triangle)[3] = collider.vertices[i];
+        if (triangle_overlaps_box(triangle, collider.normals[i], box_min, box_max))
         {
-            if (registry.debug)
-            {
-                draw_debug(vertex1, vertex2, { 0.f, 1.f, 0.f }, DebugType::fill);
-                draw_debug(vertex2, vertex3, { 0.f, 1.f, 0.f }, DebugType::fill);
-                draw_debug(vertex3, vertex1, { 0.f, 1.f, 0.f }, DebugType::fill);
-            }
+            // Keep testing in debug mode to highlight every overlapping triangle
+            if (!registry.debug) return true;
+            draw_debug(triangle[0], triangle[1], { 0.f, 1.f, 0.f }, DebugType::fill);
+            draw_debug(triangle[1], triangle[2], { 0.f, 1.f, 0.f }, DebugType::fill);
+            draw_debug(triangle[2], triangle[0], { 0.f, 1.f, 0.f }, DebugType::fill);
             result = true;
         }
     }
     return result;
 }
 
+bool CollisionSystem::is_mesh_colliding(const Entity& primary, const Entity& other_entity)
+{
+    assert(registry.mesh_colliders.has(primary) && "Missing collider mesh for target");
+
+    // Runs on worker threads, prepare_mesh_colliders() transformed the collider beforehand
+    const TransformedCollider& collider = collider_cache.lookup(primary);
+
+    const Motion& other_motion = registry.motions.get(other_entity);
+    const vec2 half = glm::abs(other_motion.collider / 2.f);
+    if (!registry.sweptColliders.has(other_entity))
+    {
+        return collider_overlaps_box(collider, other_motion.position - half, other_motion.position + half);
+    }
+
+    // Fast entities are tested along their movement, in steps no longer than their own box
+    const vec2 start = registry.sweptColliders.get(other_entity).start_position;
+    const vec2 delta = other_motion.position - start;
+    const float step = std::max(2.f * std::min(half.x, half.y), 1.f);
+    const int steps = std::min(std::max((int)std::ceil(glm::length(delta) / step), 1), MAX_SWEEP_STEPS);
+    for (int k = 1; k <= steps; k++)
+    {
+        const vec2 center = start + delta * ((float)k / (float)steps);
+        if (collider_overlaps_box(collider, center - half, center + half)) return true;
+    }
+    return false;
+}
+
 bool CollisionSystem::isWaterProtected(const Entity& player, const Entity& attacker)
 {
-    for (auto& spell : registry.spellStates.entities)
+    // A barrier follows the player, so only spells around the player are candidates
+    const Motion& player_motion = registry.motions.get(player);
+    const vec2 half = glm::abs(player_motion.collider / 2.f);
+    nearby.clear();
+    spatial_index.queryAABB(player_motion.position - half, player_motion.position + half, nearby, ECSRegistry::component_bit<SpellState>());
+    for (const Entity& spell : nearby)
     {
         SpellState& state = registry.spellStates.get(spell);
         if (state.isBarrier)
@@ -243,215 +295,317 @@ bool CollisionSystem::isWaterProtected(const Entity& player, const Entity& attac
     return false;
 }
 
-void CollisionSystem::resolve_collisions()
+void CollisionSystem::register_handler(CollisionCategory category, CategoryHandler handler, NarrowphaseTest test)
 {
-    // Ordering matters for which types of entites are checked (careful when changing)
+    handlers[(int)category] = handler;
+    narrowphase_tests[(int)category] = test;
+}
+
+// Projectile pairs take precedence over enemy pairs, which take precedence over interactable pairs.
+// Returns false for pairs nothing reacts to.
+bool CollisionSystem::classify(const Entity& entity, const Entity& other_entity, CollisionCategory& category, EntityPair& ordered) const
+{
+    const ComponentMask player_bit = ECSRegistry::component_bit<Player>();
+    const ComponentMask enemy_bit = ECSRegistry::component_bit<Enemy>();
+    const ComponentMask projectile_bit = ECSRegistry::component_bit<Projectile>();
+    const ComponentMask interactable_bit = ECSRegistry::component_bit<Interactable>();
+
+    const ComponentMask mask = registry.mask_of(entity);
+    const ComponentMask other_mask = registry.mask_of(other_entity);
+    const bool swap = !(mask & projectile_bit) && ((other_mask & projectile_bit)
+        || (!(mask & enemy_bit) && ((other_mask & enemy_bit) || (!(mask & interactable_bit) && (other_mask & interactable_bit)))));
 
-    // Water Barrier with other projectile collisions (can't be done within the projectile <-> projectile logic below)
-    std::unordered_map<SpellType, int, SpellTypeHash> cycle_progress;
-    std::unordered_map<PostResolution, std::pair<Entity, std::vector<Entity>>> post_resolutions;
-    std::unordered_set<Entity> to_deactivate;
-    std::unordered_set<Entity> to_delete;
+    const ComponentMask primary = swap ? other_mask : mask;
+    const ComponentMask other = swap ? mask : other_mask;
+    ordered = swap ? EntityPair{ other_entity, entity } : EntityPair{ entity, other_entity };
 
-    // Projectile collisions
-    for (const Entity& proj_entity : registry.projectiles.entities)
+    if (primary & projectile_bit)
     {
-        Projectile& projectile = registry.projectiles.get(proj_entity);
+        const Deadly& deadly = registry.deadlies.get(ordered.first);
+        if ((other & player_bit) && deadly.to_player) category = CollisionCategory::PROJECTILE_PLAYER;
+        else if ((other & enemy_bit) && deadly.to_enemy) category = CollisionCategory::PROJECTILE_ENEMY;
+        else return false; // projectile <-> projectile has no interaction
+    }
+    else if (primary & enemy_bit)
+    {
+        if ((other & player_bit) && registry.deadlies.get(ordered.first).to_player) category = CollisionCategory::ENEMY_PLAYER;
+        else return false; // enemy <-> enemy has no interaction
+    }
+    else if ((primary & interactable_bit) && (other & player_bit))
+    {
+        category = CollisionCategory::INTERACTABLE_PLAYER;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
 
-        std::unordered_set<Entity> other_entities = registry.collision_registry.get_collision_by_ent(proj_entity);
-        const Deadly& deadly = registry.deadlies.get(proj_entity);
-        for (const Entity& other_entity : other_entities)
+// Transform every mesh collider for this tick up front, the narrowphase then only reads the cache
+void CollisionSystem::prepare_mesh_colliders()
+{
+    for (unsigned int i = 0; i < registry.mesh_colliders.size(); i++)
+    {
+        const Entity& entity = registry.mesh_colliders.entities[i];
+        const AssetId& mesh = registry.mesh_colliders.components[i].mesh;
+        if (!registry.motions.has(entity)) continue;
+        if (!collider_cache.has(mesh)) collider_cache.load(mesh, *renderer->getMesh(mesh));
+        collider_cache.get(entity, mesh, registry.motions.get(entity));
+    }
+}
+
+void CollisionSystem::run_narrowphase(std::vector<Contact>& contacts, NarrowphaseTest test)
+{
+    if (!test)
+    {
+        // The broadphase overlap is all this category needs
+        for (Contact& contact : contacts) contact.touching = true;
+        return;
+    }
+
+    const auto run = [this, &contacts, test](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
         {
+            contacts[i].touching = (this->*test)(contacts[i].pair);
+        }
+    };
 
-            // projectile <-> player
-            if (registry.players.has(other_entity) && deadly.to_player)
+    // Debug drawing adds entities, so debug mode stays on this thread, as do batches too small to be worth it
+    if (registry.debug || contacts.size() < PARALLEL_NARROWPHASE_MIN_CONTACTS)
+    {
+        run(0, contacts.size());
+        return;
+    }
+    workers.parallel_for(contacts.size(), PARALLEL_NARROWPHASE_GRAIN, run);
+}
+
+bool CollisionSystem::mesh_contact(const EntityPair& pair)
+{
+    return is_mesh_colliding(pair.second, pair.first);
+}
+
+// Only power ups are picked up on contact, altars react to proximity
+bool CollisionSystem::pickup_contact(const EntityPair& pair)
+{
+    return registry.interactables.get(pair.first).type == InteractableType::POWER && is_mesh_colliding(pair.second, pair.first);
+}
+
+// Max level wind pulls in every enemy within its area
+void CollisionSystem::apply_wind_pull()
+{
+    for (unsigned int i = 0; i < registry.spellProjectiles.size(); i++)
+    {
+        const Entity& wind_entity = registry.spellProjectiles.entities[i];
+        SpellProjectile& spell_proj = registry.spellProjectiles.components[i];
+        if (spell_proj.type != SpellType::WIND || spell_proj.level < MAX_SPELL_LEVEL) continue;
+        if (registry.deaths.has(wind_entity) || !registry.deadlies.get(wind_entity).to_enemy) continue;
+
+        const Motion& windMotion = registry.motions.get(wind_entity);
+        const vec2 half = glm::abs(windMotion.collider / 2.f);
+        nearby.clear();
+        spatial_index.queryAABB(windMotion.position - half, windMotion.position + half, nearby, ECSRegistry::component_bit<Enemy>());
+        for (const Entity& enemy_entity : nearby)
+        {
+            spell_proj.victims.insert(enemy_entity);
+            Motion& enemyMotion = registry.motions.get(enemy_entity);
+            vec2 direction_normalized = glm::normalize(windMotion.position - enemyMotion.position);
+            enemyMotion.velocity = direction_normalized * 0.05f;
+            registry.enemies.get(enemy_entity).movementRestricted = true;
+        }
+    }
+}
+
+void CollisionSystem::resolve_collisions()
+{
+    // Each pair is classified once into its category's bucket
+    for (std::vector<Contact>& bucket : buckets)
+    {
+        bucket.clear();
+    }
+    registry.collision_registry.each_pair([this](const Entity& entity, const Entity& other_entity) {
+        CollisionCategory category;
+        EntityPair ordered = { entity, other_entity };
+        if (classify(entity, other_entity, category, ordered))
+        {
+            buckets[(int)category].push_back({ ordered, false });
+        }
+    });
+
+    // Read-only narrowphase, parallel across pairs
+    prepare_mesh_colliders();
+    for (int category = 0; category < (int)CollisionCategory::COUNT; category++)
+    {
+        run_narrowphase(buckets[category], narrowphase_tests[category]);
+    }
+
+    // Effects are applied serially, category by category in bucket order, so results do not depend on threading.
+    // Ordering matters for which types of entites are checked (careful when changing)
+    apply_wind_pull();
+    ResolutionContext context;
+    for (int category = 0; category < (int)CollisionCategory::COUNT; category++)
+    {
+        if (!buckets[category].empty() && handlers[category])
+        {
+            (this->*handlers[category])(buckets[category], context);
+        }
+    }
+
+    // Post-collision resolutions
+    Player& player = registry.players.get(registry.players.entities[0]);
+    for (const auto& spell : context.cycle_progress)
+    {
+        player.spell_queue.addProgressSpell(spell.first, spell.second);
+    }
+    resolve_post_effects(context.post_resolutions);
+    for (const Entity& ent : context.to_delete)
+    {
+        registry.deaths.emplace(ent);
+    }
+    for (const Entity& ent : context.to_deactivate)
+    {
+        Projectile& proj = registry.projectiles.get(ent);
+        proj.isActive = false;
+    }
+}
+
+void CollisionSystem::resolve_projectile_player(const std::vector<Contact>& contacts, ResolutionContext& context)
+{
+    for (const Contact& contact : contacts)
+    {
+        const Entity& proj_entity = contact.pair.first;
+        const Entity& player_entity = contact.pair.second;
+        if (contact.touching)
+        {
+            HitTypes hit_response = applyDamage(proj_entity, player_entity, context.cycle_progress);
+            if (hit_response == HitTypes::hit || hit_response == HitTypes::absorbed)
             {
-                if (is_mesh_colliding(other_entity, proj_entity))
-                {
-                    HitTypes hit_response = applyDamage(proj_entity, other_entity, cycle_progress);
-                    if (hit_response == HitTypes::hit || hit_response == HitTypes::absorbed)
-                    {
-                        registry.deaths.emplace(proj_entity);
-                    }
-                    projectile.isActive = false;
-                }
+                registry.deaths.emplace(proj_entity);
             }
+            registry.projectiles.get(proj_entity).isActive = false;
+        }
+    }
+}
 
-            // projectile <-> enemies
-            else if (registry.enemies.has(other_entity) && deadly.to_enemy)
-            {
-                // if not a spell, currently not a case OR inactive
-                if (!registry.spellProjectiles.has(proj_entity))
-                {
-                    registry.collision_registry.remove_collision(proj_entity, other_entity);
-                    continue;
-                }
+void CollisionSystem::resolve_projectile_enemy(const std::vector<Contact>& contacts, ResolutionContext& context)
+{
+    for (const Contact& contact : contacts)
+    {
+        const Entity& proj_entity = contact.pair.first;
+        const Entity& enemy_entity = contact.pair.second;
 
-                // must be spell
-                SpellProjectile& spell_proj = registry.spellProjectiles.get(proj_entity);
-                bool isMaxLevel = spell_proj.level >= MAX_SPELL_LEVEL;
-                bool didHit = false;
-
-                // Max level wind pull effect
-                if (isMaxLevel && spell_proj.type == SpellType::WIND) {
-                    spell_proj.victims.insert(other_entity);
-                    Motion& enemyMotion = registry.motions.get(other_entity);
-                    Motion& windMotion = registry.motions.get(proj_entity);
-                    vec2 direction_normalized = glm::normalize(windMotion.position - enemyMotion.position);
-                    enemyMotion.velocity = direction_normalized * 0.05f;
-                    registry.enemies.get(other_entity).movementRestricted = true;
-                }
+        // if not a spell, currently not a case OR inactive
+        if (!registry.spellProjectiles.has(proj_entity)) continue;
 
-                if (projectile.isActive)
-                {
-                    didHit = applyDamage(proj_entity, other_entity, cycle_progress, !isMaxLevel) == HitTypes::hit;
-                }
+        Projectile& projectile = registry.projectiles.get(proj_entity);
+        SpellProjectile& spell_proj = registry.spellProjectiles.get(proj_entity);
+        bool isMaxLevel = spell_proj.level >= MAX_SPELL_LEVEL;
 
-                if (isMaxLevel)
+        if (projectile.isActive)
+        {
+            applyDamage(proj_entity, enemy_entity, context.cycle_progress, !isMaxLevel);
+        }
+
+        if (isMaxLevel)
+        {
+            switch (spell_proj.type)
+            {
+            case (SpellType::FIRE):
+            {
+                if (spell_proj.isPostAttack)
                 {
-                    switch (spell_proj.type)
-                    {
-                    case (SpellType::FIRE):
-                    {
-                        if (spell_proj.isPostAttack)
-                        {
-                            // splash
-                            to_deactivate.insert(proj_entity);
-                        }
-                        else
-                        {
-                            // projectile
-                            to_delete.insert(proj_entity);
-                            if (post_resolutions.find(PostResolution::FIRE_PROJECTILE) != post_resolutions.end())
-                            {
-                                post_resolutions[PostResolution::FIRE_PROJECTILE].second.push_back(other_entity);
-                            }
-                            else
-                            {
-                                post_resolutions[PostResolution::FIRE_PROJECTILE].first = proj_entity;
-                                post_resolutions[PostResolution::FIRE_PROJECTILE].second.push_back(other_entity);
-                            }
-                        }
-                    }
-                    case (SpellType::LIGHTNING):
-                    {
-                        to_deactivate.insert(proj_entity);
-                    }
-                    case (SpellType::WATER): {}
-                    }
+                    // splash
+                    context.to_deactivate.insert(proj_entity);
                 }
                 else
                 {
-                    switch (spell_proj.type)
+                    // projectile
+                    context.to_delete.insert(proj_entity);
+                    auto resolution = context.post_resolutions.find(PostResolution::FIRE_PROJECTILE);
+                    if (resolution != context.post_resolutions.end())
                     {
-                    case (SpellType::WATER):
-                    {
-                        to_deactivate.insert(proj_entity);
-                        break;
-                    }
-                    case (SpellType::ICE):
-                    case (SpellType::FIRE):
-                    {
-                        projectile.isActive = false;
-                        to_delete.insert(proj_entity);
+                        resolution->second.second.push_back(enemy_entity);
                     }
-                    case (SpellType::LIGHTNING):
-                    case (SpellType::PLASMA):
-                    case (SpellType::WIND):
+                    else
                     {
-                        break;
-                    }
+                        context.post_resolutions.emplace(PostResolution::FIRE_PROJECTILE, std::make_pair(proj_entity, std::vector<Entity>({ enemy_entity })));
                     }
                 }
+                // a max fire projectile is deactivated like lightning as well
+                context.to_deactivate.insert(proj_entity);
+                break;
             }
-
-            else if (registry.projectiles.has(other_entity) && deadly.to_projectile)
+            case (SpellType::LIGHTNING):
             {
-                // projectile <-> projectile interaction
+                context.to_deactivate.insert(proj_entity);
+                break;
+            }
+            default:
+                break;
             }
-
-            registry.collision_registry.remove_collision(proj_entity, other_entity);
         }
-    }
-
-    // Enemies collisions
-    for (const Entity& enemy_entity : registry.enemies.entities)
-    {
-        std::unordered_set<Entity> other_entities = registry.collision_registry.get_collision_by_ent(enemy_entity);
-        const Deadly& deadly = registry.deadlies.get(enemy_entity);
-        for (const Entity& other_entity : other_entities)
+        else
         {
-
-            if (registry.players.has(other_entity) && deadly.to_player)
+            switch (spell_proj.type)
             {
-                if (is_mesh_colliding(other_entity, enemy_entity))
-                {
-                    applyDamage(enemy_entity, other_entity, cycle_progress);
-                }
+            case (SpellType::WATER):
+            {
+                context.to_deactivate.insert(proj_entity);
+                break;
             }
-
-            else if (registry.enemies.has(other_entity) && deadly.to_enemy)
+            case (SpellType::ICE):
+            case (SpellType::FIRE):
             {
-                // enemy <-> enemy interaction
+                projectile.isActive = false;
+                context.to_delete.insert(proj_entity);
+                break;
+            }
+            default:
+                break;
             }
-
-            registry.collision_registry.remove_collision(enemy_entity, other_entity);
         }
     }
+}
 
-    // TODO: add check for terrain collisions
-
-    for (const Entity& interactable_entity : registry.interactables.entities)
+void CollisionSystem::resolve_enemy_player(const std::vector<Contact>& contacts, ResolutionContext& context)
+{
+    for (const Contact& contact : contacts)
     {
-        std::unordered_set<Entity> other_entities = registry.collision_registry.get_collision_by_ent(interactable_entity);
-        const Interactable& interactable = registry.interactables.get(interactable_entity);
-        for (const Entity& other_entity : other_entities)
+        if (contact.touching)
         {
-            if (!registry.collision_registry.check_collision(interactable_entity, other_entity)) continue;
-            if (registry.players.has(other_entity))
-            {
-                if (interactable.type == InteractableType::POWER && is_mesh_colliding(other_entity, interactable_entity))
-                {
-                    SoundManager* sound = SoundManager::getSoundManager();
-                    sound->playSound(SoundEffect::POWERUP_PICKUP);
-
-                    SpellUnlock& unlock = registry.spellUnlocks.get(interactable_entity);
-                    pickupSpell(other_entity, unlock.type);
-                    Decay& decay = registry.decays.get(interactable_entity);
-                    decay.timer = 0;
-                }
-                if (interactable.type == InteractableType::BOSS)
-                {
-                    interactProx.in_proximity = Proximity::BOSS_ALTAR;
-                }
-                else if (interactable.type == InteractableType::PLASMA)
-                {
-                    interactProx.in_proximity = Proximity::PLASMA_SUMMON;
-                }
-            }
-
-            registry.collision_registry.remove_collision(interactable_entity, other_entity);
+            applyDamage(contact.pair.first, contact.pair.second, context.cycle_progress);
         }
     }
+}
 
-    // Post-collision resolutions
-    Player& player = registry.players.get(registry.players.entities[0]);
-    for (const auto& spell : cycle_progress)
-    {
-        player.spell_queue.addProgressSpell(spell.first, spell.second);
-    }
-    resolve_post_effects(post_resolutions);
-    post_resolutions.clear();
-    for (const Entity& ent : to_delete)
-    {
-        registry.deaths.emplace(ent);
-    }
-    for (const Entity& ent : to_deactivate)
+void CollisionSystem::resolve_interactable_player(const std::vector<Contact>& contacts, ResolutionContext&)
+{
+    for (const Contact& contact : contacts)
     {
-        Projectile& proj = registry.projectiles.get(ent);
-        proj.isActive = false;
-    }
+        const Entity& interactable_entity = contact.pair.first;
+        const Entity& player_entity = contact.pair.second;
+        const Interactable& interactable = registry.interactables.get(interactable_entity);
+
+        // touching is only set for power ups
+        if (contact.touching)
+        {
+            SoundManager* sound = SoundManager::getSoundManager();
+            sound->playSound(SoundEffect::POWERUP_PICKUP);
 
+            SpellUnlock& unlock = registry.spellUnlocks.get(interactable_entity);
+            pickupSpell(player_entity, unlock.type);
+            Decay& decay = registry.decays.get(interactable_entity);
+            decay.timer = 0;
+        }
+        if (interactable.type == InteractableType::BOSS)
+        {
+            interactProx.in_proximity = Proximity::BOSS_ALTAR;
+        }
+        else if (interactable.type == InteractableType::PLASMA)
+        {
+            interactProx.in_proximity = Proximity::PLASMA_SUMMON;
+        }
+    }
 }
 
 void CollisionSystem::resolve_post_effects(std::unordered_map<PostResolution, std::pair<Entity, std::vector<Entity>>> resolutions)
@@ -602,7 +756,7 @@ HitTypes CollisionSystem::applyDamage(Entity attacker, Entity victim, std::unord
             // Stop movement and remove from AI system to prevent any future movement
             Motion& motion = registry.motions.get(victim);
             motion.velocity = { 0.0f, 0.0f };
-            registry.ai_systems.remove(victim);
+            registry.commands.remove(registry.ai_systems, victim);
 
             // Trigger death animation
             Animation& dead_ent_animation = registry.animations.get(victim);
@@ -0,0 +1,186 @@
+#include "core/occupancy_grid.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+OccupancyGrid occupancy_grid; // Static terrain, baked by the world system with the tile grid
+
+void OccupancyGrid::reset(const vec2& origin, const vec2& col_axis, const vec2& row_axis, int cols, int rows)
+{
+    this->origin = origin - (col_axis + row_axis) * 0.5f;
+    this->col_axis = col_axis;
+    this->row_axis = row_axis;
+    this->cols = std::max(cols, 0);
+    this->rows = std::max(rows, 0);
+
+    const float det = col_axis.x * row_axis.y - col_axis.y * row_axis.x;
+    to_col = vec2(row_axis.y, -row_axis.x) / det;
+    to_row = vec2(-col_axis.y, col_axis.x) / det;
+
+    cell_min = glm::min(glm::min(vec2(0.f), col_axis), glm::min(row_axis, col_axis + row_axis));
+    cell_max = glm::max(glm::max(vec2(0.f), col_axis), glm::max(row_axis, col_axis + row_axis));
+    cell_width = std::abs(det) / std::max(glm::length(col_axis), glm::length(row_axis));
+
+    blocked_count = 0;
+    bits.assign(((size_t)this->cols * this->rows + 63) / 64, 0);
+}
+
+vec2 OccupancyGrid::to_grid(const vec2& position) const
+{
+    const vec2 offset = position - origin;
+    return { dot(to_col, offset), dot(to_row, offset) };
+}
+
+void OccupancyGrid::setBlocked(int col, int row, bool blocked)
+{
+    if (col < 0 || col >= cols || row < 0 || row >= rows) return;
+
+    const size_t index = (size_t)row * cols + col;
+    const uint64_t bit = uint64_t(1) << (index & 63);
+    const bool was_blocked = (bits[index >> 6] & bit) != 0;
+    if (was_blocked == blocked) return;
+
+    if (blocked)
+    {
+        bits[index >> 6] |= bit;
+        blocked_count++;
+    }
+    else
+    {
+        bits[index >> 6] &= ~bit;
+        blocked_count--;
+    }
+}
+
+void OccupancyGrid::setBlocked(const vec2& position, bool blocked)
+{
+    const vec2 cell = to_grid(position);
+    setBlocked((int)std::floor(cell.x), (int)std::floor(cell.y), blocked);
+}
+
+bool OccupancyGrid::isBlocked(int col, int row) const
+{
+    if (col < 0 || col >= cols || row < 0 || row >= rows) return false;
+
+    const size_t index = (size_t)row * cols + col;
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+bool OccupancyGrid::isBlocked(const vec2& position) const
+{
+    const vec2 cell = to_grid(position);
+    return isBlocked((int)std::floor(cell.x), (int)std::floor(cell.y));
+}
+
+bool OccupancyGrid::isBoxBlocked(const vec2& min, const vec2& max) const
+{
+    if (empty()) return false;
+
+    // The cells under the grid space bounds of the box...
+    const vec2 corners[] = { to_grid(min), to_grid({ max.x, min.y }), to_grid({ min.x, max.y }), to_grid(max) };
+    vec2 grid_min = corners[0];
+    vec2 grid_max = corners[0];
+    for (const vec2& corner : corners)
+    {
+        grid_min = glm::min(grid_min, corner);
+        grid_max = glm::max(grid_max, corner);
+    }
+
+    // A box ending exactly on a cell edge does not reach into the next cell
+    const int first_col = std::max((int)std::floor(grid_min.x), 0);
+    const int first_row = std::max((int)std::floor(grid_min.y), 0);
+    const int last_col = std::min((int)std::ceil(grid_max.x) - 1, cols - 1);
+    const int last_row = std::min((int)std::ceil(grid_max.y) - 1, rows - 1);
+
+    for (int row = first_row; row <= last_row; row++)
+    {
+        for (int col = first_col; col <= last_col; col++)
+        {
+            if (!isBlocked(col, row)) continue;
+
+            // ...minus the ones whose world bounds miss it, together a separating axis test of box and cell
+            const vec2 corner = origin + (float)col * col_axis + (float)row * row_axis;
+            if (min.x < corner.x + cell_max.x && max.x > corner.x + cell_min.x &&
+                min.y < corner.y + cell_max.y && max.y > corner.y + cell_min.y) return true;
+        }
+    }
+    return false;
+}
+
+bool OccupancyGrid::isSegmentClear(const vec2& from, const vec2& to) const
+{
+    if (empty()) return true;
+
+    // Walk the cells crossed by the segment in order (Amanatides & Woo)
+    const vec2 start = to_grid(from);
+    const vec2 end = to_grid(to);
+    const vec2 delta = end - start;
+
+    int col = (int)std::floor(start.x);
+    int row = (int)std::floor(start.y);
+    const int end_col = (int)std::floor(end.x);
+    const int end_row = (int)std::floor(end.y);
+    const int step_col = delta.x > 0 ? 1 : -1;
+    const int step_row = delta.y > 0 ? 1 : -1;
+
+    const float t_delta_col = delta.x != 0 ? std::abs(1.f / delta.x) : INFINITY;
+    const float t_delta_row = delta.y != 0 ? std::abs(1.f / delta.y) : INFINITY;
+    float t_max_col = delta.x != 0 ? ((col + (step_col > 0 ? 1 : 0)) - start.x) / delta.x : INFINITY;
+    float t_max_row = delta.y != 0 ? ((row + (step_row > 0 ? 1 : 0)) - start.y) / delta.y : INFINITY;
+
+    const int cells = std::abs(end_col - col) + std::abs(end_row - row);
+    for (int i = 0; i <= cells; i++)
+    {
+        if (isBlocked(col, row)) return false;
+
+        if (t_max_col < t_max_row)
+        {
+            col += step_col;
+            t_max_col += t_delta_col;
+        }
+        else
+        {
+            row += step_row;
+            t_max_row += t_delta_row;
+        }
+    }
+    return true;
+}
+
+vec2 OccupancyGrid::resolveMovement(const vec2& from, const vec2& to, const vec2& half_extents) const
+{
+    // Movers already overlapping terrain (spawned or restored inside it) are let out
+    if (empty() || isBoxBlocked(from - half_extents, from + half_extents)) return to;
+
+    const vec2 movement = to - from;
+    const float max_step = cell_width * 0.5f;
+    const int steps = std::max(1, (int)std::ceil(std::max(std::abs(movement.x), std::abs(movement.y)) / max_step));
+    const vec2 step = movement / (float)steps;
+
+    // Resolve each axis on its own so movers slide along walls instead of sticking to them
+    vec2 position = from;
+    for (int i = 0; i < steps; i++)
+    {
+        const vec2 moved_x = { position.x + step.x, position.y };
+        if (!isBoxBlocked(moved_x - half_extents, moved_x + half_extents)) position.x = moved_x.x;
+
+        const vec2 moved_y = { position.x, position.y + step.y };
+        if (!isBoxBlocked(moved_y - half_extents, moved_y + half_extents)) position.y = moved_y.y;
+    }
+    return position;
+}
+
+vec2 OccupancyGrid::steerAround(const vec2& position, const vec2& direction, float lookahead) const
+{
+    if (empty() || isSegmentClear(position, position + direction * lookahead)) return direction;
+
+    // Try turning further and further away from the wanted direction, alternating sides
+    const float turns[] = { M_PI / 4.f, -M_PI / 4.f, M_PI / 2.f, -M_PI / 2.f, 3.f * M_PI / 4.f, -3.f * M_PI / 4.f };
+    for (float turn : turns)
+    {
+        const float c = cos(turn);
+        const float s = sin(turn);
+        const vec2 turned = { direction.x * c - direction.y * s, direction.x * s + direction.y * c };
+        if (isSegmentClear(position, position + turned * lookahead)) return turned;
+    }
+    return direction;
+}
@@ -6,7 +6,7 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
-#include <glm/gtc/type_ptr.inl>
+#include <glm/gtc/type_ptr.hpp>
 #include "stb_image.h"
 #include "core/common.hpp"
 #include <glm/gtc/matrix_transform.hpp>
@@ -16,6 +16,7 @@
 #include "graphics/video_player.hpp"
 #include "utils/spell_queue.hpp"
 #include "utils/isometric_helper.hpp"
+#include "graphics/tile_generator.hpp"
 
 std::string spellTypeToCollect(SpellType spell) {
 	switch (spell) {
@@ -97,7 +98,12 @@ bool RenderSystem::initialize(IInputHandler& input_handler,
 		};
 
 	auto mouse_button_redirect = [](GLFWwindow* wnd, int _1, int _2, int _3) {
-		((RenderSystem*)glfwGetWindowUserPointer(wnd))->input_handler->onMouseKey(wnd, _1, _2, _3);
+		IInputHandler* input_handler = ((RenderSystem*)glfwGetWindowUserPointer(wnd))->input_handler;
+		// fixes issue where mouse position isn't set until mouse is moved
+		double x, y;
+		glfwGetCursorPos(wnd, &x, &y);
+		input_handler->onMouseMove({ x, y });
+		input_handler->onMouseKey(_1, _2, _3);
 		};
 
 	glfwSetKeyCallback(window, key_redirect);
@@ -138,7 +144,7 @@ void RenderSystem::setUpView() const
 }
 
 void RenderSystem::initializeCamera() {
-	camera = Entity();
+	camera = Entity::create();
 	registry.cameras.emplace(camera);
 }
 /**
@@ -151,13 +157,43 @@ GLFWwindow* RenderSystem::getGLWindow() const
 	return this->window;
 }
 
+bool RenderSystem::shouldClose() const
+{
+	return glfwWindowShouldClose(window);
+}
+
+void RenderSystem::getFramebufferSize(int& width, int& height) const
+{
+	glfwGetFramebufferSize(window, &width, &height);
+}
+
+/**
+ * @brief Build the background tile layer
+ * Replaces the tile layer of a previous game, if any
+ */
+void RenderSystem::buildTileLayer(TileGenerator& tile_generator)
+{
+	auto existing = sub_renderers.find("tiles");
+	if (existing != sub_renderers.end()) {
+		delete existing->second;
+		sub_renderers.erase(existing);
+	}
+
+	auto* batchRenderer = new BatchRenderer();
+	tile_generator.generateTiles(batchRenderer);
+	batchRenderer->finalizeBatches();
+	addSubRenderer("tiles", batchRenderer);
+}
+
 /**
  * @brief Draw the frame
  * This function is called every frame to draw the frame
  * @attention Skips rendering if the shader is not found
  */
-void RenderSystem::drawFrame(float elapsed_ms)
+void RenderSystem::drawFrame(float elapsed_ms, float alpha)
 {
+	frame_alpha = alpha;
+
 	if (globalOptions.tutorial) {
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	}
@@ -284,8 +320,9 @@ void RenderSystem::drawFrame(float elapsed_ms)
 	}
 
 	Entity player = registry.players.entities[0];
-	float playerX = registry.motions.get(player).position.x - window_width_px / 6.0;
-	float playerY = registry.motions.get(player).position.y - window_height_px / 6.0;
+	const vec2 player_position = interpolatedPosition(player);
+	float playerX = player_position.x - window_width_px / 6.0;
+	float playerY = player_position.y - window_height_px / 6.0;
 
 	updateCameraPosition(clamp(playerX, 0.f, (float)(2.0 * window_width_px / 3.0)),
 		clamp(playerY, 0.f, (float)(2.0 * window_height_px / 3.0)));
@@ -296,22 +333,24 @@ void RenderSystem::drawFrame(float elapsed_ms)
 	drawBackgroundObjects();
 
 	// Draw all entities
-	// registry.render_requests.sort(typeAscending);
+	// Entities with a motion and a render request are kept at the front of both containers in matching order,
+	// so a render request's index is also the index of its motion
+	const size_t drawable_count = registry.group<Motion, RenderRequest>().size();
 	this->updateRenderOrder(registry.render_requests);
 
 	for (const auto& render_index : sorted_indices)
 	{
-		Entity& entity = registry.render_requests.entities.at(render_index.index);
-		RenderRequest& render_request = registry.render_requests.get(entity);
+		Entity& entity = registry.render_requests.entities[render_index.index];
+		RenderRequest& render_request = registry.render_requests.components[render_index.index];
 
-		if (!registry.motions.has(entity))
+		if (render_index.index >= drawable_count)
 		{
 			std::cerr << "Entity " << entity << " does not have a motion component" << std::endl;
 			std::cerr << "Skipping rendering of this entity" << std::endl;
 			continue;
 		}
 
-		Motion& motion = registry.motions.get(entity);
+		Motion& motion = registry.motions.components[render_index.index];
 
 		Camera& gameCamera = registry.cameras.get(camera);
 		if (motion.position.x < gameCamera.position.x - RENDER_PAST_SCREEN_OFFSET
@@ -334,7 +373,7 @@ void RenderSystem::drawFrame(float elapsed_ms)
 
 			vec2 position;
 			if (registry.motions.has(entity)) {
-				position = registry.motions.get(entity).position;
+				position = render_request.smooth_position.interpolate(motion.position, frame_alpha);
 			}
 			else {
 				// Fallback to render_y if no Motion component
@@ -630,12 +669,28 @@ void RenderSystem::drawParticles() {
 	const Mesh* mesh = this->asset_manager->getMesh("particle");
 	glBindVertexArray(mesh->vao);
 	glBindBuffer(GL_ARRAY_BUFFER, mesh->instanceVBO);
-	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Particle) * registry.particles.size(), registry.particles.components.data());
+	// Particles are stored in blocks, upload each contiguous block after the previous one
+	const BlockVector<Particle>& particles = registry.particles.components;
+	GLintptr offset = 0;
+	for (size_t b = 0; b < particles.block_count(); b++) {
+		const GLsizeiptr block_bytes = sizeof(Particle) * particles.block_size(b);
+		glBufferSubData(GL_ARRAY_BUFFER, offset, block_bytes, particles.block_data(b));
+		offset += block_bytes;
+	}
 
 	glDrawElementsInstanced(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT, 0, registry.particles.size());
 	//printd("Current Particles: %d\n", registry.particles.size());
 }
 
+// Position of an entity between its last two simulation ticks, for the current frame
+vec2 RenderSystem::interpolatedPosition(const Entity& entity) const {
+	const vec2& position = registry.motions.get(entity).position;
+	if (!registry.render_requests.has(entity)) {
+		return position;
+	}
+	return registry.render_requests.get(entity).smooth_position.interpolate(position, frame_alpha);
+}
+
 void RenderSystem::updateCameraPosition(float x, float y) {
 	Camera& gameCamera = registry.cameras.get(camera);
 	gameCamera.position.x = 3 * x / 4;
@@ -691,8 +746,14 @@ void RenderSystem::drawHealthBars() {
 
 		glUniform1f(glGetUniformLocation(shaderProgram, "proportionFilled"), health.health / health.maxHealth);
 
+		// Health bars follow their entity's drawn position
+		vec2 position = healthBar.position;
+		if (registry.motions.has(healthBar.assignedTo)) {
+			position += interpolatedPosition(healthBar.assignedTo) - registry.motions.get(healthBar.assignedTo).position;
+		}
+
 		mat4 transform = mat4(1.0f);
-		transform = translate(transform, glm::vec3(healthBar.position, 0.0f));
+		transform = translate(transform, glm::vec3(position, 0.0f));
 		transform = scale(transform, glm::vec3(healthBar.scale * renderScaleModifier * zoomFactor, 1.0f));
 		mat4 projection = projectionMatrix;
 		mat4 view = viewMatrix;
@@ -1081,6 +1142,12 @@ bool RenderSystem::isPlayingVideo() const {
 
 void RenderSystem::playCutscene(const std::string& filename, Song song) {
 	stopVideo();
+	if (!globalOptions.cutscenes) {
+		// Skipped, the game goes on as if it had ended
+		globalOptions.pause = false;
+		globalOptions.introPlayed = true;
+		return;
+	}
 	globalOptions.pause = true;
 	SoundManager* soundManager = SoundManager::getSoundManager();
 	soundManager->stopMusic();
@@ -0,0 +1,148 @@
+#include "core/spatial_hash.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cell_size)
+{
+    set_cell_size(cell_size);
+}
+
+void SpatialHash::set_cell_size(float size)
+{
+    assert(size > 0.f && "Spatial hash cell size must be positive");
+    cell_size = size;
+    inv_cell_size = 1.f / size;
+}
+
+void SpatialHash::clear()
+{
+    proxies.clear();
+}
+
+int SpatialHash::to_cell(float value) const
+{
+    return static_cast<int>(std::floor(value * inv_cell_size));
+}
+
+size_t SpatialHash::bucket_of(int cell_x, int cell_y) const
+{
+    // bucket count is always a power of two
+    const unsigned int hash = (static_cast<unsigned int>(cell_x) * 73856093u) ^ (static_cast<unsigned int>(cell_y) * 19349663u);
+    return hash & (buckets.size() - 1);
+}
+
+void SpatialHash::insert(const Entity& entity, const vec2& center, const vec2& half_extents, uint32_t layer, uint32_t mask)
+{
+    Proxy proxy{ entity, center - half_extents, center + half_extents, layer, mask, {}, {} };
+    proxy.min_cell = { to_cell(proxy.min.x), to_cell(proxy.min.y) };
+    proxy.max_cell = { to_cell(proxy.max.x), to_cell(proxy.max.y) };
+    proxies.push_back(proxy);
+}
+
+void SpatialHash::build()
+{
+    for (unsigned int bucket : used_buckets)
+    {
+        buckets[bucket].clear();
+    }
+    used_buckets.clear();
+
+    // Keep roughly two buckets per proxy so chains stay short
+    size_t wanted = 64;
+    while (wanted < proxies.size() * 2) wanted <<= 1;
+    if (buckets.size() < wanted)
+    {
+        buckets.resize(wanted);
+    }
+
+    for (unsigned int i = 0; i < proxies.size(); i++)
+    {
+        const Proxy& proxy = proxies[i];
+        for (int y = proxy.min_cell.y; y <= proxy.max_cell.y; y++)
+        {
+            for (int x = proxy.min_cell.x; x <= proxy.max_cell.x; x++)
+            {
+                std::vector<unsigned int>& bucket = buckets[bucket_of(x, y)];
+                if (bucket.empty()) used_buckets.push_back(static_cast<unsigned int>(bucket_of(x, y)));
+                bucket.push_back(i);
+            }
+        }
+    }
+}
+
+void SpatialHash::find_pairs(std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    build();
+
+    for (unsigned int i = 0; i < proxies.size(); i++)
+    {
+        const Proxy& proxy = proxies[i];
+        for (int y = proxy.min_cell.y; y <= proxy.max_cell.y; y++)
+        {
+            for (int x = proxy.min_cell.x; x <= proxy.max_cell.x; x++)
+            {
+                candidate_boxes.clear();
+                candidates.clear();
+                for (unsigned int j : buckets[bucket_of(x, y)])
+                {
+                    // each unordered pair is only considered from its lower index
+                    if (j <= i) continue;
+                    if (!layers_interact(proxy.layer, proxy.mask, proxies[j].layer, proxies[j].mask)) continue;
+                    candidates.push_back(j);
+                    candidate_boxes.push_back(proxies[j].min, proxies[j].max);
+                }
+                if (candidate_boxes.overlap_mask(proxy.min, proxy.max, hits) == 0) continue;
+
+                for (size_t c = 0; c < candidates.size(); c++)
+                {
+                    if (!hits[c]) continue;
+
+                    // Pairs sharing several cells (or hash-colliding cells) are only reported
+                    // from the cell holding the top-left corner of their intersection
+                    const Proxy& other = proxies[candidates[c]];
+                    if (to_cell(std::max(proxy.min.x, other.min.x)) != x
+                        || to_cell(std::max(proxy.min.y, other.min.y)) != y)
+                    {
+                        continue;
+                    }
+
+                    pairs.push_back({ proxy.entity, other.entity });
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::query(const vec2& min, const vec2& max, std::vector<unsigned int>& proxy_ids) const
+{
+    if (buckets.empty()) return;
+
+    const ivec2 min_cell = { to_cell(min.x), to_cell(min.y) };
+    const ivec2 max_cell = { to_cell(max.x), to_cell(max.y) };
+    const size_t first = proxy_ids.size();
+    for (int y = min_cell.y; y <= max_cell.y; y++)
+    {
+        for (int x = min_cell.x; x <= max_cell.x; x++)
+        {
+            for (unsigned int id : buckets[bucket_of(x, y)])
+            {
+                const Proxy& proxy = proxies[id];
+                if (proxy.min.x > max.x || min.x > proxy.max.x || proxy.min.y > max.y || min.y > proxy.max.y)
+                {
+                    continue;
+                }
+
+                // Proxies covering several queried cells are only reported from the first cell they share
+                if (std::max(proxy.min_cell.x, min_cell.x) != x || std::max(proxy.min_cell.y, min_cell.y) != y)
+                {
+                    continue;
+                }
+                proxy_ids.push_back(id);
+            }
+        }
+    }
+
+    // A proxy can still show up twice if two of its cells hash to the same bucket
+    std::sort(proxy_ids.begin() + first, proxy_ids.end());
+    proxy_ids.erase(std::unique(proxy_ids.begin() + first, proxy_ids.end()), proxy_ids.end());
+}
@@ -0,0 +1,124 @@
+#include "core/spatial_index.hpp"
+#include <algorithm>
+
+SpatialIndex spatial_index; // Global neighbour queries, maintained by the world system
+
+SpatialIndex::SpatialIndex(float cell_size) : own_grid(cell_size), grid(&own_grid)
+{
+}
+
+void SpatialIndex::share_broadphase(SpatialHash* broadphase)
+{
+    grid = broadphase ? broadphase : &own_grid;
+}
+
+void SpatialIndex::clear()
+{
+    grid->clear();
+    grid->build();
+    bounds_min = bounds_max = vec2(0.f);
+}
+
+void SpatialIndex::update(ECSRegistry& registry)
+{
+    bounds_min = vec2(INFINITY);
+    bounds_max = vec2(-INFINITY);
+
+    // The broadphase already bucketed this tick's colliders, only the bounds are left
+    if (grid != &own_grid)
+    {
+        for (unsigned int id = 0; id < grid->size(); id++)
+        {
+            bounds_min = glm::min(bounds_min, grid->proxy(id).min);
+            bounds_max = glm::max(bounds_max, grid->proxy(id).max);
+        }
+        return;
+    }
+
+    own_grid.clear();
+    ComponentContainer<Motion>& motions = registry.motions;
+    for (unsigned int i = 0; i < motions.size(); i++)
+    {
+        const Entity& entity = motions.entities[i];
+        if (!registry.collisionLayers.has(entity) || registry.deaths.has(entity)) continue;
+
+        const Motion& motion = motions.components[i];
+        const vec2 half = glm::abs(motion.collider / 2.f);
+        own_grid.insert(entity, motion.position, half, 0, 0);
+        bounds_min = glm::min(bounds_min, motion.position - half);
+        bounds_max = glm::max(bounds_max, motion.position + half);
+    }
+    own_grid.build();
+}
+
+bool SpatialIndex::accepts(const Entity& entity, ComponentMask required) const
+{
+    return (registry.mask_of(entity) & required) == required;
+}
+
+float SpatialIndex::distance_squared(const vec2& point, unsigned int proxy_id) const
+{
+    const SpatialHash::Proxy& proxy = grid->proxy(proxy_id);
+    const vec2 closest = glm::clamp(point, proxy.min, proxy.max);
+    const vec2 offset = point - closest;
+    return dot(offset, offset);
+}
+
+void SpatialIndex::queryAABB(const vec2& min, const vec2& max, std::vector<Entity>& out, ComponentMask required)
+{
+    proxy_ids.clear();
+    grid->query(min, max, proxy_ids);
+    for (unsigned int id : proxy_ids)
+    {
+        const Entity& entity = grid->proxy(id).entity;
+        if (accepts(entity, required)) out.push_back(entity);
+    }
+}
+
+void SpatialIndex::queryRadius(const vec2& center, float radius, std::vector<Entity>& out, ComponentMask required)
+{
+    proxy_ids.clear();
+    grid->query(center - vec2(radius), center + vec2(radius), proxy_ids);
+    for (unsigned int id : proxy_ids)
+    {
+        const Entity& entity = grid->proxy(id).entity;
+        if (distance_squared(center, id) <= radius * radius && accepts(entity, required)) out.push_back(entity);
+    }
+}
+
+void SpatialIndex::nearestK(const vec2& center, unsigned int k, std::vector<Entity>& out, ComponentMask required, float max_distance)
+{
+    if (k == 0 || grid->size() == 0) return;
+
+    // Grow the searched region until it holds k candidates or covers everything indexed
+    const vec2 reach = glm::max(glm::abs(bounds_min - center), glm::abs(bounds_max - center));
+    const float max_radius = std::min(std::max(reach.x, reach.y), max_distance);
+    float radius = std::min(grid->get_cell_size(), max_radius);
+    for (;;)
+    {
+        by_distance.clear();
+        proxy_ids.clear();
+        grid->query(center - vec2(radius), center + vec2(radius), proxy_ids);
+        for (unsigned int id : proxy_ids)
+        {
+            const float distance = distance_squared(center, id);
+            // Only the circle is complete, something outside the queried square may be closer than its corners
+            if (distance <= radius * radius && accepts(grid->proxy(id).entity, required))
+            {
+                by_distance.push_back({ distance, grid->proxy(id).entity });
+            }
+        }
+        if (by_distance.size() >= k || radius >= max_radius) break;
+        radius = std::min(radius * 2.f, max_radius);
+    }
+
+    const size_t count = std::min<size_t>(k, by_distance.size());
+    std::partial_sort(by_distance.begin(), by_distance.begin() + count, by_distance.end(),
+        [](const std::pair<float, Entity>& a, const std::pair<float, Entity>& b) {
+            return a.first < b.first || (a.first == b.first && (unsigned int)a.second < (unsigned int)b.second);
+        });
+    for (size_t i = 0; i < count; i++)
+    {
+        out.push_back(by_distance[i].second);
+    }
+}
@@ -0,0 +1,147 @@
+#include "core/sweep_and_prune.hpp"
+
+const unsigned int SweepAndPrune::INVALID_PROXY;
+
+void SweepAndPrune::clear()
+{
+    // Proxies persist, only the ones that are not submitted again this tick get dropped
+    tick++;
+}
+
+void SweepAndPrune::insert(const Entity& entity, const vec2& center, const vec2& half_extents, uint32_t layer, uint32_t mask)
+{
+    const unsigned int index = entity.index();
+    if (index >= proxy_of_entity.size())
+    {
+        proxy_of_entity.resize(index + 1, INVALID_PROXY);
+    }
+
+    unsigned int proxy_id = proxy_of_entity[index];
+    if (proxy_id == INVALID_PROXY || !(proxies[proxy_id].entity == entity))
+    {
+        // The slot may still hold the proxy of a released entity, it is dropped as stale on the next sweep
+        const Proxy created = { entity, {}, {}, layer, mask, tick, 0, true };
+        if (!free_proxies.empty())
+        {
+            proxy_id = free_proxies.back();
+            free_proxies.pop_back();
+            proxies[proxy_id] = created;
+        }
+        else
+        {
+            proxy_id = (unsigned int)proxies.size();
+            proxies.push_back(created);
+        }
+        proxy_of_entity[index] = proxy_id;
+        endpoints.push_back({ 0.f, proxy_id, true });
+        endpoints.push_back({ 0.f, proxy_id, false });
+    }
+
+    Proxy& proxy = proxies[proxy_id];
+    // min/max so a start endpoint can never sort after its own end
+    proxy.min = glm::min(center - half_extents, center + half_extents);
+    proxy.max = glm::max(center - half_extents, center + half_extents);
+    proxy.layer = layer;
+    proxy.mask = mask;
+    proxy.tick = tick;
+}
+
+bool SweepAndPrune::endpoint_less(const Endpoint& a, const Endpoint& b)
+{
+    // On equal values, starts go first so touching intervals count as overlapping
+    return a.value < b.value || (a.value == b.value && a.is_min && !b.is_min);
+}
+
+void SweepAndPrune::remove_stale_proxies()
+{
+    bool any_stale = false;
+    for (unsigned int i = 0; i < proxies.size(); i++)
+    {
+        Proxy& proxy = proxies[i];
+        if (proxy.in_use && proxy.tick != tick)
+        {
+            proxy.in_use = false;
+            free_proxies.push_back(i);
+            if (proxy_of_entity[proxy.entity.index()] == i)
+            {
+                proxy_of_entity[proxy.entity.index()] = INVALID_PROXY;
+            }
+            any_stale = true;
+        }
+    }
+    if (!any_stale) return;
+
+    // Compact in place, the remaining endpoints stay sorted
+    size_t write = 0;
+    for (size_t read = 0; read < endpoints.size(); read++)
+    {
+        if (proxies[endpoints[read].proxy].in_use)
+        {
+            endpoints[write++] = endpoints[read];
+        }
+    }
+    endpoints.resize(write);
+}
+
+void SweepAndPrune::sort_endpoints()
+{
+    for (Endpoint& endpoint : endpoints)
+    {
+        const Proxy& proxy = proxies[endpoint.proxy];
+        endpoint.value = endpoint.is_min ? proxy.min.x : proxy.max.x;
+    }
+
+    // Insertion sort, nearly sorted input thanks to frame-to-frame coherence
+    for (size_t i = 1; i < endpoints.size(); i++)
+    {
+        const Endpoint endpoint = endpoints[i];
+        size_t j = i;
+        while (j > 0 && endpoint_less(endpoint, endpoints[j - 1]))
+        {
+            endpoints[j] = endpoints[j - 1];
+            j--;
+        }
+        endpoints[j] = endpoint;
+    }
+}
+
+void SweepAndPrune::find_pairs(std::vector<std::pair<Entity, Entity>>& pairs)
+{
+    remove_stale_proxies();
+    sort_endpoints();
+
+    active.clear();
+    active_boxes.clear();
+    for (const Endpoint& endpoint : endpoints)
+    {
+        Proxy& proxy = proxies[endpoint.proxy];
+        if (endpoint.is_min)
+        {
+            // Every active interval started before this one and has not ended yet, so x overlaps
+            // and the batch test only rejects on y
+            if (active_boxes.overlap_mask(proxy.min, proxy.max, hits) > 0)
+            {
+                for (size_t slot = 0; slot < active.size(); slot++)
+                {
+                    if (!hits[slot]) continue;
+                    const Proxy& other = proxies[active[slot]];
+                    if (layers_interact(proxy.layer, proxy.mask, other.layer, other.mask))
+                    {
+                        pairs.push_back({ other.entity, proxy.entity });
+                    }
+                }
+            }
+            proxy.active_slot = (unsigned int)active.size();
+            active.push_back(endpoint.proxy);
+            active_boxes.push_back(proxy.min, proxy.max);
+        }
+        else
+        {
+            const unsigned int moved = active.back();
+            active[proxy.active_slot] = moved;
+            proxies[moved].active_slot = proxy.active_slot;
+            active.pop_back();
+            active_boxes.swap_pop(proxy.active_slot);
+        }
+    }
+}
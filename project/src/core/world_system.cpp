@@ -6,6 +6,12 @@
 #include "graphics/tile_generator.hpp"
 #include "utils/serializer.hpp"
 #include "utils/enemy_factory.hpp"
+#include "utils/collision_layers.hpp"
+#include "core/spatial_index.hpp"
+#include "core/occupancy_grid.hpp"
+#include "utils/profiler.hpp"
+#include "utils/rng.hpp"
+#include "utils/state_hash.hpp"
 #include <utils/spell_factory.hpp>
 
 WorldSystem::WorldSystem(IRenderSystem* renderer)
@@ -18,7 +24,7 @@ WorldSystem::~WorldSystem() {}
 
 // Should the game be over ?
 bool WorldSystem::isOver() const {
-	return bool(glfwWindowShouldClose(window));
+	return renderer->shouldClose();
 }
 
 // Update our game world
@@ -35,22 +41,34 @@ bool WorldSystem::step(float elapsed_ms_since_last_update) {
 		return true;
 	}
 
+	// Debug shapes show the last tick, so they stay up on frames that run no tick
+	registry.clear_debug_requests();
 	interactProx.in_proximity = Proximity::NONE;
 
-	this->handleProjectiles(elapsed_ms_since_last_update);
-	this->handle_enemy_logic(elapsed_ms_since_last_update);
-	this->handleMovements(elapsed_ms_since_last_update);
-	this->collision_system->detect_collisions();
-	this->collision_system->resolve_collisions();
-	this->handleAnimations();
-	this->handleHealthBars();
-	this->handleRain();
-	this->handleTimers(elapsed_ms_since_last_update);
-	this->handleAI(elapsed_ms_since_last_update);
-	this->handleSpellStates(elapsed_ms_since_last_update);
-	this->handleInteractable();
-	particleSystem.updateParticles(elapsed_ms_since_last_update);
+	const float elapsed_ms = elapsed_ms_since_last_update;
+	profiler.measure("projectiles", [&] { handleProjectiles(elapsed_ms); });
+	profiler.measure("enemy spawns", [&] { handle_enemy_logic(elapsed_ms); });
+	profiler.measure("movement", [&] { handleMovements(elapsed_ms); });
+	profiler.measure("collision detection", [&] { collision_system->detect_collisions(); });
+	profiler.measure("spatial index", [&] { spatial_index.update(registry); });
+	profiler.measure("collision resolution", [&] { collision_system->resolve_collisions(); });
+	profiler.measure("animations", [&] { handleAnimations(); });
+	profiler.measure("health bars", [&] { handleHealthBars(); });
+	profiler.measure("rain", [&] { handleRain(); });
+	profiler.measure("timers", [&] { handleTimers(elapsed_ms); });
+	profiler.measure("ai", [&] { handleAI(elapsed_ms); });
+	profiler.measure("spell states", [&] { handleSpellStates(elapsed_ms); });
+	profiler.measure("interactables", [&] { handleInteractable(); });
+	profiler.measure("particles", [&] { particleSystem.updateParticles(elapsed_ms); });
+	profiler.measure("commands", [&] { registry.flush_commands(); });
 	registry.collision_registry.clear_collisions();
+
+	// Rendering interpolates between the positions of the last two ticks
+	registry.group<Motion, RenderRequest>().each([](Entity, Motion& motion, RenderRequest& render_request) {
+		render_request.smooth_position.snapshot(motion.position);
+	});
+	if (state_hash_log.isOpen()) profiler.measure("state hash", [&] { state_hash_log.record(); });
+	profiler.tick();
 	return true;
 }
 
@@ -66,12 +84,10 @@ void WorldSystem::handleAI(float elapsed_ms_since_last_update) {
 }
 
 void WorldSystem::handleRain() {
-	std::random_device rd;	// Random device
-	std::mt19937 gen(rd()); // Mersenne Twister generator
-	std::uniform_real_distribution<float> pos_distr(0, window_width_px);
-	std::uniform_real_distribution<float> vel_distr(0.1, 0.4);
+	Pcg32& rng = rng_service.stream(RngStream::VISUALS);
 	for (int i = 0; i < 10; i++) {
-		particleSystem.emitParticle({ pos_distr(gen), 0 }, { 0, vel_distr(gen) }, 4000, 4);
+		const float x = rng.uniform(0, window_width_px);
+		particleSystem.emitParticle({ x, 0 }, { 0, rng.uniform(0.1, 0.4) }, 4000, 4);
 	}
 }
 
@@ -94,9 +110,10 @@ void WorldSystem::handleHealthBars() {
 			// Update healthbar position to match the entity it's assigned to
 			Entity assignedTo = healthbar.assignedTo;
 
-			// If enemy has died during collision, destroy its health bar
-			if (registry.deaths.has(assignedTo) && registry.enemies.has(assignedTo)) {
-				registry.remove_all_components_of(entity);
+			// If enemy has died during collision or no longer exists, destroy its health bar
+			if (!registry.valid(assignedTo) || (registry.deaths.has(assignedTo) && registry.enemies.has(assignedTo))) {
+				registry.commands.destroy(entity);
+				continue;
 			}
 
 			if (!registry.motions.has(assignedTo)) {
@@ -113,15 +130,8 @@ void WorldSystem::handleHealthBars() {
 }
 
 void WorldSystem::handleAnimations() {
-	for (Entity e : registry.animations.entities) {
-		if (!registry.players.has(e) && !registry.enemies.has(e)) {
-			continue;
-		}
-
-		Motion& motion = registry.motions.get(e);
-		Animation& animation = registry.animations.get(e);
-		RenderRequest& rr = registry.render_requests.get(e);
-
+	// Only players and enemies have directional sprite sheets
+	auto animate = [this](Entity e, const auto& /* player or enemy */, Animation& animation, Motion& motion, RenderRequest& rr) {
 		if (animation.state == AnimationState::ATTACKING) {
 			animation.oneTime = true;
 			rr.texture = peToString(e) + "-attack";
@@ -157,12 +167,15 @@ void WorldSystem::handleAnimations() {
 			}
 
 			if (motion.currentDirection == motion.oldDirection) {
-				continue;
+				return;
 			}
 
 			animation.initializeAtRow((int)motion.currentDirection);
 		}
-	}
+	};
+
+	registry.view<Player, Animation, Motion, RenderRequest>().each(animate);
+	registry.view<Enemy, Animation, Motion, RenderRequest>().each(animate);
 	// printd("Current: %d\n", playerMotion.currentDirection);
 }
 /**
@@ -172,16 +185,8 @@ void WorldSystem::handleAnimations() {
  */
 void WorldSystem::handleProjectiles(float elapsed_ms_since_last_update)
 {
-	for (Entity& projectile_ent : registry.projectiles.entities)
+	registry.view<Projectile, Motion, Deadly>(exclude<Death>).each([&](Entity projectile_ent, Projectile& projectile, Motion& motion, Deadly& deadly)
 	{
-		if (registry.deaths.has(projectile_ent))
-		{
-			continue;
-		}
-
-		Projectile& projectile = registry.projectiles.get(projectile_ent);
-		Motion& motion = registry.motions.get(projectile_ent);
-		Deadly& deadly = registry.deadlies.get(projectile_ent);
 		bool doLinear = registry.spellProjectiles.has(projectile_ent) ? !registry.spellProjectiles.get(projectile_ent).isPostAttack : true;
 
 		projectile.range -= projectile.type == DamageType::portal ? elapsed_ms_since_last_update : sqrt(motion.velocity.x * motion.velocity.x + motion.velocity.y * motion.velocity.y) * elapsed_ms_since_last_update;
@@ -234,7 +239,7 @@ void WorldSystem::handleProjectiles(float elapsed_ms_since_last_update)
 			// printd("Marked for removal due to distance travelled - Entity value:
 			// %u\n", static_cast<unsigned>(projectile_ent));
 		}
-	}
+	});
 }
 
 /**
@@ -244,64 +249,63 @@ void WorldSystem::handleProjectiles(float elapsed_ms_since_last_update)
  */
 void WorldSystem::handleMovements(float elapsed_ms_since_last_update)
 {
-	ComponentContainer<Motion>& motions_registry = registry.motions;
-	Motion& player_motion = motions_registry.get(player_mage);
-
-	// Update all motions
-	for (Entity entity : motions_registry.entities)
-	{
-		Motion& motion = motions_registry.get(entity);
-
-		if (registry.players.has(entity) || registry.enemies.has(entity))
-		{
-			float x_offset = motion.collider.x * motion.scale.x;
-			float y_offset = motion.collider.y * motion.scale.y;
-
-			float slowFactor = 1;
-			if (registry.debuffs.has(entity)) {
-				Debuff& debuff = registry.debuffs.get(entity);
-				if (debuff.type == DebuffType::SLOW) {
-					slowFactor = debuff.strength;
-				}
+	Motion& player_motion = registry.motions.get(player_mage);
+
+	// Players and enemies walk, clamped to the window and blocked by terrain
+	auto walk = [&](Entity entity, Motion& motion) {
+		float x_offset = motion.collider.x * motion.scale.x;
+		float y_offset = motion.collider.y * motion.scale.y;
+
+		float slowFactor = 1;
+		if (registry.debuffs.has(entity)) {
+			Debuff& debuff = registry.debuffs.get(entity);
+			if (debuff.type == DebuffType::SLOW) {
+				slowFactor = debuff.strength;
 			}
+		}
 
-			motion.position = glm::clamp(motion.position + motion.velocity * slowFactor * elapsed_ms_since_last_update, { x_offset, y_offset }, { window_width_px - x_offset, window_height_px - y_offset });
-
-			if (registry.enemies.has(entity))
-			{
-				// Enemy& enemy = registry.enemies.get(entity);
-				motion.angle = atan2(player_motion.position.y - motion.position.y,
-					player_motion.position.x - motion.position.x);
-
-				// printd("Enemy angle towards player: %f\n", motion.angle);
-			}
-
-			if (registry.enemies.has(entity) && registry.enemies.get(entity).movementRestricted) {
-
-			}
-			else {
-				computeNewDirection(entity);
-			}
+		const vec2 half_extents = glm::abs(vec2(x_offset, y_offset)) / 2.f;
+		const vec2 moved = glm::clamp(motion.position + motion.velocity * slowFactor * elapsed_ms_since_last_update, { x_offset, y_offset }, { window_width_px - x_offset, window_height_px - y_offset });
+		motion.position = occupancy_grid.resolveMovement(motion.position, moved, half_extents);
+	};
+	registry.view<Motion, Player>().each([&](Entity entity, Motion& motion, Player&) { walk(entity, motion); });
+	registry.view<Motion, Enemy>().each([&](Entity entity, Motion& motion, Enemy&) { walk(entity, motion); });
+
+	registry.view<Motion, Player>().each([&](Entity entity, Motion&, Player&) {
+		computeNewDirection(entity);
+	});
+
+	// Enemies face the player's new position
+	registry.view<Motion, Enemy>().each([&](Entity entity, Motion& motion, Enemy& enemy) {
+		motion.angle = atan2(player_motion.position.y - motion.position.y,
+			player_motion.position.x - motion.position.x);
+		// printd("Enemy angle towards player: %f\n", motion.angle);
+
+		if (!enemy.movementRestricted) {
+			computeNewDirection(entity);
 		}
+	});
 
-		// not a player nor enemy
-		else if (registry.projectiles.has(entity)) {
-			Projectile& projectile = registry.projectiles.get(entity);
+	registry.view<Motion, Projectile>(exclude<Player, Enemy>).each([&](Entity entity, Motion& motion, Projectile& projectile) {
+		// Collisions of fast projectiles are tested along the movement of this tick
+		if (registry.sweptColliders.has(entity)) {
+			registry.sweptColliders.get(entity).start_position = motion.position;
+		}
 
-			if (projectile.type == DamageType::water) {
-				motion.position = player_motion.position;
-			}
-			else if (projectile.type == DamageType::lightning) {
-				// lightning attack doesn't move
-			}
-			else {
-				motion.position += motion.velocity * elapsed_ms_since_last_update;
-			}
+		if (projectile.type == DamageType::water) {
+			motion.position = player_motion.position;
+		}
+		else if (projectile.type == DamageType::lightning) {
+			// lightning attack doesn't move
+		}
+		else {
+			motion.position += motion.velocity * elapsed_ms_since_last_update;
 		}
+	});
 
-		RenderRequest& render_request = registry.render_requests.get(entity);
+	registry.group<Motion, RenderRequest>().each([](Entity, Motion& motion, RenderRequest& render_request) {
 		render_request.smooth_position.update(motion.position.y);
-	}
+	});
 }
 
 void WorldSystem::computeNewDirection(Entity e) {
@@ -430,7 +434,7 @@ void WorldSystem::handleTimers(float elapsed_ms_since_last_update)
 		heal.heal_time -= elapsed_ms_since_last_update;
 		if (heal.heal_time < 0)
 		{
-			registry.onHeals.remove(healed_ent);
+			registry.commands.remove(registry.onHeals, healed_ent);
 		}
 	}
 
@@ -450,7 +454,7 @@ void WorldSystem::handleTimers(float elapsed_ms_since_last_update)
 				bossDefeated = true;
 				boss_music_delay_timer = 10.f;
 			}
-			registry.remove_all_components_of(dead_ent);
+			registry.commands.destroy(dead_ent);
 		}
 	}
 
@@ -468,8 +472,11 @@ void WorldSystem::handleTimers(float elapsed_ms_since_last_update)
 				}
 				registry.spellProjectiles.get(decay_ent).victims.clear();
 			}
-			Death& death = registry.deaths.emplace(decay_ent);
-			death.timer = 0;
+			// Already queued for destruction by the deaths loop above
+			if (!registry.deaths.has(decay_ent)) {
+				Death& death = registry.deaths.emplace(decay_ent);
+				death.timer = 0;
+			}
 		}
 	}
 
@@ -479,7 +486,7 @@ void WorldSystem::handleTimers(float elapsed_ms_since_last_update)
 		debuff.timer -= elapsed_ms_since_last_update;
 		if (debuff.timer < 0)
 		{
-			registry.debuffs.remove(debuff_ent);
+			registry.commands.remove(registry.debuffs, debuff_ent);
 		}
 	}
 
@@ -550,17 +557,13 @@ void WorldSystem::handleSpellStates(float elapsed_ms_since_last_update)
 		vec2 position = lightnings_to_create.front();
 		lightnings_to_create.pop();
 
-		std::random_device rand;
-		std::mt19937 gen(rand());
-		std::uniform_real_distribution<float> distance(MAX_LIGHTNING_POS_DIFFERENCE.x, MAX_LIGHTNING_POS_DIFFERENCE.y);
-		vec2 new_position = vec2(position);
 		SpellFactory::createSpellProjectile(
 			registry,
 			registry.players.entities[0],
 			SpellType::LIGHTNING,
 			-1,
-			(position.x + distance(gen)),
-			(position.y + distance(gen)),
+			position.x,
+			position.y,
 			true);
 	}
 
@@ -619,10 +622,22 @@ void WorldSystem::handleSpellStates(float elapsed_ms_since_last_update)
 					{
 						if (!spell_state.isChild)
 						{
+							// Chain to the closest enemies, bolts without a target land around the first strike
 							Motion& motion = registry.motions.get(spell_ent);
+							std::vector<Entity> targets;
+							spatial_index.nearestK(motion.position, MAX_LIGHTNING_ATTACK_COUNT, targets, ECSRegistry::component_bit<Enemy>(), MAX_LIGHTNING_CHAIN_RADIUS);
+
+							Pcg32& rng = rng_service.stream(RngStream::SPELLS);
 							for (int x = 0; x < MAX_LIGHTNING_ATTACK_COUNT; x++)
 							{
-								lightnings_to_create.push(vec2(motion.position));
+								if (x < (int)targets.size()) {
+									lightnings_to_create.push(registry.motions.get(targets[x]).position);
+								}
+								else {
+									const float offset_x = rng.uniform(MAX_LIGHTNING_POS_DIFFERENCE.x, MAX_LIGHTNING_POS_DIFFERENCE.y);
+									const float offset_y = rng.uniform(MAX_LIGHTNING_POS_DIFFERENCE.x, MAX_LIGHTNING_POS_DIFFERENCE.y);
+									lightnings_to_create.push(motion.position + vec2(offset_x, offset_y));
+								}
 							}
 						}
 					}
@@ -661,10 +676,12 @@ void WorldSystem::handleSpellStates(float elapsed_ms_since_last_update)
  */
 void WorldSystem::initialize() {
 	restartGame();
+	collision_system->init();
 }
 
 void WorldSystem::restartGame() {
 	registry.reset_registry();
+	spatial_index.clear();
 	if (registry.players.entities.size() > 0)
 	{
 		registry.clear_all_components();
@@ -712,20 +729,19 @@ void WorldSystem::reloadGame() {
 
 void WorldSystem::createTileGrid() {
 	int w, h;
-	glfwGetFramebufferSize(renderer->getGLWindow(), &w, &h);
+	renderer->getFramebufferSize(w, h);
 	vec2 gridDim = IsometricGrid::getGridDimensions(w, h);
 	int numCols = static_cast<int>(gridDim.x);
 	int numRows = static_cast<int>(gridDim.y);
-	auto* batchRenderer = new BatchRenderer();
 
 	TileGenerator tileGenerator(numCols, numRows, w, h, true);
-	tileGenerator.generateTiles(batchRenderer);
-	batchRenderer->finalizeBatches();
-	renderer->addSubRenderer("tiles", batchRenderer);
+	renderer->buildTileLayer(tileGenerator);
+
+	tileGenerator.bakeOccupancy(occupancy_grid, TERRAIN_BLOCKED_NOISE);
 }
 
 Entity WorldSystem::createPlayer() {
-	auto player = Entity();
+	auto player = Entity::create();
 
 	Player& player_component = registry.players.emplace(player);
 	player_component.spell_queue = SpellQueue();
@@ -741,7 +757,7 @@ Entity WorldSystem::createPlayer() {
 	health.health = PLAYER_HEALTH;
 	health.maxHealth = PLAYER_MAX_HEALTH;
 
-	auto healthBar = Entity();
+	auto healthBar = Entity::create();
 	HealthBar& healthBarComp = registry.healthBars.emplace(healthBar);
 	healthBarComp.assignHealthBar(player);
 	healthBarComp.position = { motion.position.x, motion.position.y - HEALTH_BAR_Y_OFFSET };
@@ -764,6 +780,8 @@ Entity WorldSystem::createPlayer() {
 	MeshCollider& collider = registry.mesh_colliders.emplace(player);
 	collider.mesh = "mage_collider";
 
+	assignCollisionLayer(registry, player);
+
 	return player;
 }
 
@@ -798,7 +816,7 @@ void WorldSystem::loadBackgroundObjects() {
 
 Entity WorldSystem::createBackgroundObject(vec2 position, vec2 scale, AssetId texture, bool animate)
 {
-	Entity object;
+	Entity object = Entity::create();
 
 	Motion& motion = registry.motions.emplace(object);
 	motion.position = position;
@@ -882,8 +900,7 @@ void WorldSystem::handle_enemy_logic(const float elapsed_ms_since_last_update)
 
 	if (should_spawn_knight || should_spawn_archer || should_spawn_paladin || should_spawn_slasher || should_spawn_darklord)
 	{
-		std::random_device rd;	// Random device
-		std::mt19937 gen(rd()); // Mersenne Twister generator
+		Pcg32& rng = rng_service.stream(RngStream::ENEMY_SPAWNS);
 		enum SIDE
 		{
 			TOP,
@@ -891,31 +908,29 @@ void WorldSystem::handle_enemy_logic(const float elapsed_ms_since_last_update)
 			BOTTOM,
 			LEFT
 		}; // Side of the window to spawn from
-		std::uniform_int_distribution<int> side_dis(TOP, LEFT);
-		const int side = side_dis(gen);
+		const int side = rng.uniformInt(TOP, LEFT);
 
 		float candidate_x = 0.f, candidate_y = 0.f;
-		std::uniform_real_distribution<float> dis(0.f, 1.f);
 		constexpr float offset_x = window_width_px / 10.f;
 		constexpr float offset_y = window_height_px / 10.f;
 
 		switch (side) {
 		case TOP:
-			candidate_x = dis(gen) * window_width_px;
+			candidate_x = rng.uniform(0.f, 1.f) * window_width_px;
 			candidate_y = -offset_y;
 			break;
 		case RIGHT:
 			candidate_x = window_width_px + offset_x;
-			candidate_y = dis(gen) * window_height_px;
+			candidate_y = rng.uniform(0.f, 1.f) * window_height_px;
 			break;
 		case BOTTOM:
-			candidate_x = dis(gen) * window_width_px;
+			candidate_x = rng.uniform(0.f, 1.f) * window_width_px;
 			candidate_y = window_height_px + offset_y;
 			break;
 		case LEFT:
 		default: // Should never happen but just in case
 			candidate_x = -offset_x;
-			candidate_y = dis(gen) * window_height_px;
+			candidate_y = rng.uniform(0.f, 1.f) * window_height_px;
 			break;
 		}
 		const vec2 position = { candidate_x, candidate_y };
@@ -983,24 +998,21 @@ void WorldSystem::handleCollectible(const float elapsed_ms_since_last_update)
 	}
 	if (powerup_timer <= 0)
 	{
-		std::random_device rd;	// Random device
-		std::mt19937 gen(rd()); // Mersenne Twister generator
-		std::uniform_real_distribution<float> hor_distr(0 + POWERUP_SPAWN_BUFFER, window_width_px - POWERUP_SPAWN_BUFFER);
-		std::uniform_real_distribution<float> ver_distr(0 + POWERUP_SPAWN_BUFFER, window_height_px - POWERUP_SPAWN_BUFFER);
+		Pcg32& rng = rng_service.stream(RngStream::COLLECTIBLES);
 
 		Motion& motion = registry.motions.get(player_mage);
 		Player& player = registry.players.get(player_mage);
 		SoundManager* sound_manager = SoundManager::getSoundManager();
-		std::uniform_int_distribution<int> spell_choice(0, static_cast<int>(SpellType::COUNT) - 1 - NOT_DROPPED_SPELL_COUNT);
+		const int last_dropped_spell = static_cast<int>(SpellType::COUNT) - 1 - NOT_DROPPED_SPELL_COUNT;
 		while (true)
 		{
-			float x = hor_distr(gen);
-			float y = ver_distr(gen);
+			float x = rng.uniform(0 + POWERUP_SPAWN_BUFFER, window_width_px - POWERUP_SPAWN_BUFFER);
+			float y = rng.uniform(0 + POWERUP_SPAWN_BUFFER, window_height_px - POWERUP_SPAWN_BUFFER);
 			if (glm::distance(motion.position, { x , y }) > MIN_POWERUP_DIST)
 			{
 				if (registry.debug) printf("DEBUG: spawning powerup at %f %f\n", x, y);
 				sound_manager->playSound(SoundEffect::POWERUP_SPAWN);
-				createCollectible({ x, y }, static_cast<SpellType>(spell_choice(gen)));
+				createCollectible({ x, y }, static_cast<SpellType>(rng.uniformInt(0, last_dropped_spell)));
 				break;
 			}
 		}
@@ -1011,7 +1023,7 @@ void WorldSystem::handleCollectible(const float elapsed_ms_since_last_update)
 
 void WorldSystem::createCollectible(const vec2 position, const SpellType type)
 {
-	Entity entity;
+	Entity entity = Entity::create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = position;
@@ -1028,6 +1040,7 @@ void WorldSystem::createCollectible(const vec2 position, const SpellType type)
 	unlock.type = type;
 	Decay& decay = registry.decays.emplace(entity);
 	decay.timer = POWERUP_DECAY;
+	assignCollisionLayer(registry, entity);
 
 	switch (type) {
 	case SpellType::FIRE:
@@ -1049,13 +1062,13 @@ void WorldSystem::createCollectible(const vec2 position, const SpellType type)
 		request.texture = "plasma-collect";
 		break;
 	default:
-		registry.remove_all_components_of(entity);
+		registry.commands.destroy(entity);
 	}
 }
 
 void WorldSystem::createAltar()
 {
-	Entity entity;
+	Entity entity = Entity::create();
 
 	Motion& motion = registry.motions.emplace(entity);
 	motion.position = ALTAR_POSITION;
@@ -1069,11 +1082,12 @@ void WorldSystem::createAltar()
 
 	Interactable& interact = registry.interactables.emplace(entity);
 	interact.type = InteractableType::BOSS;
+	assignCollisionLayer(registry, entity);
 }
 
 void WorldSystem::createPlasmaAltar()
 {
-	Entity entity;
+	Entity entity = Entity::create();
 
 	Animation& animation = registry.animations.emplace(entity);
 	animation.spriteCols = 17;
@@ -1091,6 +1105,7 @@ void WorldSystem::createPlasmaAltar()
 
 	Interactable& interact = registry.interactables.emplace(entity);
 	interact.type = InteractableType::PLASMA;
+	assignCollisionLayer(registry, entity);
 
 	RenderRequest& request = registry.render_requests.emplace(entity);
 	request.texture = "necromancer";
@@ -1105,7 +1120,7 @@ void WorldSystem::removeInteractable(InteractableType type)
 	{
 		if (registry.interactables.get(ent).type == type)
 		{
-			registry.remove_all_components_of(ent);
+			registry.commands.destroy(ent);
 			break;
 		}
 	}
@@ -1,67 +1,95 @@
 #include "entities/collision_registry.hpp"
+#include <algorithm>
+#include <cstdio>
+
+static bool entity_less(const Entity& entity, const Entity& other_entity)
+{
+	return (unsigned int)entity < (unsigned int)other_entity;
+}
+
+static bool pair_less(const std::pair<Entity, Entity>& pairing, const std::pair<Entity, Entity>& other_pairing)
+{
+	if (!(pairing.first == other_pairing.first)) return entity_less(pairing.first, other_pairing.first);
+	return entity_less(pairing.second, other_pairing.second);
+}
 
 void CollisionRegistry::print_collision_map()
 {
-	for (auto pairing : this->collision_mapping)
+	for (size_t i = 0; i < pairs.size(); i++)
 	{
-		printf("key: %u\n   values:", (unsigned int)pairing.first);
-		for (auto value : pairing.second)
-		{
-			printf("%u ", (unsigned int)value);
-		}
-		printf("\n");
+		printf("%u <-> %u%s\n", (unsigned int)pairs[i].first, (unsigned int)pairs[i].second, pair_alive[i] ? "" : " (removed)");
 	}
 }
 
 /*
 	Build entity pairing based off first being the entity with ID lower than the second
 */
-std::pair<Entity, Entity> build_pairing(const Entity& entity, const Entity& other_entity)
+static std::pair<Entity, Entity> build_pairing(const Entity& entity, const Entity& other_entity)
 {
 	const Entity& less_entity = entity < other_entity ? entity : other_entity;
 	const Entity& more_entity = entity == less_entity ? other_entity : entity;
 	return { less_entity, more_entity };
 }
 
-bool CollisionRegistry::exists_in_both(const std::pair<Entity, Entity>& pairing)
+void CollisionRegistry::register_collision(const Entity& entity, const Entity& other_entity)
 {
-	return this->collision_mapping[pairing.first].find(pairing.second) != this->collision_mapping[pairing.first].end()
-		&& this->collision_mapping[pairing.second].find(pairing.first) != this->collision_mapping[pairing.second].end();
+	assert(!finalized && "Collisions registered after finalize()");
+	pairs.push_back(build_pairing(entity, other_entity));
 }
 
-void CollisionRegistry::register_collision(const Entity& entity, const Entity& other_entity)
+void CollisionRegistry::finalize()
 {
-	const auto pairing = build_pairing(entity, other_entity);
-	if (exists_in_both(pairing)) return;
+	std::sort(pairs.begin(), pairs.end(), pair_less);
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+	pair_alive.assign(pairs.size(), 1);
 
-	this->collision_mapping[pairing.first].insert(pairing.second);
-	this->collision_mapping[pairing.second].insert(pairing.first);
+	contacts.clear();
+	for (unsigned int i = 0; i < pairs.size(); i++)
+	{
+		contacts.push_back({ pairs[i].first, pairs[i].second, i });
+		contacts.push_back({ pairs[i].second, pairs[i].first, i });
+	}
+	std::sort(contacts.begin(), contacts.end(), [](const Contact& a, const Contact& b) {
+		if (!(a.owner == b.owner)) return entity_less(a.owner, b.owner);
+		return a.pair < b.pair;
+	});
+	finalized = true;
 }
 
-bool CollisionRegistry::check_collision(const Entity& entity, const Entity& other_entity)
+size_t CollisionRegistry::find_pair(const Entity& entity, const Entity& other_entity) const
 {
-	return exists_in_both(build_pairing(entity, other_entity));
+	assert(finalized && "Collision lookup before finalize()");
+	const auto pairing = build_pairing(entity, other_entity);
+	const auto it = std::lower_bound(pairs.begin(), pairs.end(), pairing, pair_less);
+	if (it == pairs.end() || !(*it == pairing)) return pairs.size();
+	return it - pairs.begin();
 }
 
-void CollisionRegistry::remove_collision(const Entity& entity, const Entity& other_entity)
+bool CollisionRegistry::check_collision(const Entity& entity, const Entity& other_entity) const
 {
-	const auto pairing = build_pairing(entity, other_entity);
-	if (!exists_in_both(pairing)) return;
+	const size_t pair = find_pair(entity, other_entity);
+	return pair < pairs.size() && pair_alive[pair];
+}
 
-	this->collision_mapping[pairing.first].erase(this->collision_mapping[pairing.first].find(pairing.second));
-	this->collision_mapping[pairing.second].erase(this->collision_mapping[pairing.second].find(pairing.first));
+void CollisionRegistry::remove_collision(const Entity& entity, const Entity& other_entity)
+{
+	const size_t pair = find_pair(entity, other_entity);
+	if (pair < pairs.size()) pair_alive[pair] = 0;
 }
 
-std::unordered_set<Entity> CollisionRegistry::get_collision_by_ent(const Entity& entity)
+CollisionRegistry::EntitySpan CollisionRegistry::get_collision_by_ent(const Entity& entity) const
 {
-	if (this->collision_mapping.find(entity) == this->collision_mapping.end())
-	{
-		return std::unordered_set<Entity>();
-	}
-	return this->collision_mapping[entity];
+	assert(finalized && "Collision lookup before finalize()");
+	const auto range = std::equal_range(contacts.begin(), contacts.end(), Contact{ entity, entity, 0 },
+		[](const Contact& a, const Contact& b) { return entity_less(a.owner, b.owner); });
+	const Contact* base = contacts.data();
+	return EntitySpan(base + (range.first - contacts.begin()), base + (range.second - contacts.begin()), pair_alive.data());
 }
 
 void CollisionRegistry::clear_collisions()
 {
-	this->collision_mapping.clear();
+	pairs.clear();
+	pair_alive.clear();
+	contacts.clear();
+	finalized = false;
 }
@@ -1,5 +1,77 @@
 // internal
 #include "entities/ecs.hpp"
+#include <cstdio>
+#include <cstdlib>
 
 // All we need to store besides the containers is the id of every entity and callbacks to be able to remove entities across containers
-unsigned int Entity::id_count = 1;
\ No newline at end of file
+unsigned int Entity::id_count = 1;
+const unsigned int Entity::INDEX_BITS;
+const unsigned int Entity::INDEX_MASK;
+const unsigned int Entity::GENERATION_MASK;
+const unsigned int Entity::MINIMUM_FREE_INDICES;
+
+// Function-local statics so entities created during static initialization see constructed tables
+std::vector<unsigned int>& Entity::generations()
+{
+	static std::vector<unsigned int> generations(1, 0);
+	return generations;
+}
+
+std::deque<unsigned int>& Entity::free_indices()
+{
+	static std::deque<unsigned int> free_indices;
+	return free_indices;
+}
+
+Entity Entity::create()
+{
+	std::deque<unsigned int>& free = free_indices();
+	unsigned int slot;
+	// Past the index limit, any free slot is better than none
+	if (free.size() >= MINIMUM_FREE_INDICES || (id_count > INDEX_MASK && !free.empty()))
+	{
+		slot = free.front();
+		free.pop_front();
+	}
+	else
+	{
+		if (id_count > INDEX_MASK)
+		{
+			fprintf(stderr, "Ran out of entity indices, %u entities are alive\n", INDEX_MASK);
+			abort();
+		}
+		slot = id_count++;
+		// Slots handed out before release_all() keep their generation
+		if (slot == generations().size()) generations().push_back(0);
+	}
+
+	Entity e;
+	e.id = (generations()[slot] << INDEX_BITS) | slot;
+	return e;
+}
+
+bool Entity::alive(Entity e)
+{
+	const std::vector<unsigned int>& gens = generations();
+	return e.index() != 0 && e.index() < gens.size() && gens[e.index()] == e.generation();
+}
+
+void Entity::release(Entity e)
+{
+	if (!alive(e)) return;
+	std::vector<unsigned int>& gens = generations();
+	gens[e.index()] = (gens[e.index()] + 1) & GENERATION_MASK;
+	free_indices().push_back(e.index());
+}
+
+void Entity::release_all()
+{
+	std::vector<unsigned int>& gens = generations();
+	for (unsigned int slot = 1; slot < id_count; slot++)
+	{
+		gens[slot] = (gens[slot] + 1) & GENERATION_MASK;
+	}
+	// Counting from 1 again hands out the low indices first, so the sparse arrays stay compact
+	free_indices().clear();
+	id_count = 1;
+}
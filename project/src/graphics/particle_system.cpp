@@ -1,4 +1,5 @@
 #include "graphics/particle_system.hpp"
+#include "utils/rng.hpp"
 
 ParticleSystem* ParticleSystem::instance = nullptr;
 ParticleSystem::ParticleSystem() {}
@@ -13,7 +14,7 @@ ParticleSystem* ParticleSystem::getParticleSystem() {
 void ParticleSystem::emitParticle(const vec2 position, const vec2 velocity, float lifetime, float size) {
 
 	if (registry.particles.size() < MAX_PARTICLES) {
-		auto ent = Entity();
+		auto ent = Entity::create();
 		Particle& particle = registry.particles.emplace(ent);
 		particle.position = position;
 		particle.velocity = velocity;
@@ -33,22 +34,19 @@ void ParticleSystem::updateParticles(float elapsed_ms) {
 		particle.lifetime -= elapsed_ms;
 
 		if (particle.lifetime <= 0.0f) {
-			registry.remove_all_components_of(e);
+			registry.commands.destroy(e);
 		}
 	}
 }
 
 float ParticleSystem::randomFloat(float min, float max) {
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_real_distribution<float> distr(min, max);
-
-	return distr(gen);
+	return rng_service.stream(RngStream::VISUALS).uniform(min, max);
 }
 
 void ParticleSystem::particleBurst(vec2 position) {
 	for (int i = 0; i < 30; i++) {
-		vec2 velocity = vec2(randomFloat(-0.1, 0.1), randomFloat(-0.1, 0.1));
+		const float velocity_x = randomFloat(-0.1, 0.1);
+		vec2 velocity = vec2(velocity_x, randomFloat(-0.1, 0.1));
 
 		emitParticle(position, velocity, 400, 5);
 	}
@@ -0,0 +1,145 @@
+// Simulation without window, GL or audio: steps the world as fast as possible and reports timings.
+// Usage: soulless_headless [--ticks=N] [--report-every=N] [--tick-rate=N] [--broadphase=grid|sap] [--seed=N]
+//                          [--record=FILE] [--replay=FILE] [--hash-log=FILE]
+//        soulless_headless --compare-hashes=A,B
+// A replay runs to its end instead of --ticks, with the seed and tick rate it was recorded with.
+// --hash-log writes the state hash of every tick, --compare-hashes reports the first tick where two such logs differ.
+
+#include "core/world_system.hpp"
+#include "headless/null_asset_manager.hpp"
+#include "headless/null_render_system.hpp"
+#include "input/input_handler.hpp"
+#include "utils/game_assets.hpp"
+#include "utils/command_line.hpp"
+#include "utils/profiler.hpp"
+#include "utils/rng.hpp"
+#include "utils/replay.hpp"
+#include "utils/state_hash.hpp"
+#include "entities/general_components.hpp"
+#include <chrono>
+#include <cstdio>
+
+struct HeadlessOptions {
+   long long ticks = 10 * 60 * DEFAULT_TICK_RATE; // ten minutes of game time at the default rate
+   long long report_every = 0;                   // also report every N ticks, 0 to only report at the end
+   std::string record_path;                      // write the run to this replay file
+   std::string replay_path;                      // run this replay file instead of --ticks
+   std::string compare_hashes;                   // two state hash logs A,B to compare instead of running
+};
+
+static bool parseArguments(int argc, char* argv[], HeadlessOptions& options)
+{
+   for (int i = 1; i < argc; i++) {
+       const std::string arg = argv[i];
+       const char* value = nullptr;
+       if ((value = argumentValue(arg, "--ticks"))) {
+           options.ticks = atoll(value);
+       }
+       else if ((value = argumentValue(arg, "--report-every"))) {
+           options.report_every = atoll(value);
+       }
+       else if ((value = argumentValue(arg, "--record"))) {
+           options.record_path = value;
+       }
+       else if ((value = argumentValue(arg, "--replay"))) {
+           options.replay_path = value;
+       }
+       else if ((value = argumentValue(arg, "--compare-hashes"))) {
+           options.compare_hashes = value;
+       }
+       else if (!parseSimulationArgument(arg)) {
+           fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+           return false;
+       }
+   }
+   return true;
+}
+
+int main(int argc, char* argv[])
+{
+   HeadlessOptions options;
+   if (!parseArguments(argc, argv, options)) {
+       return 1;
+   }
+
+   if (!options.compare_hashes.empty()) {
+       const size_t comma = options.compare_hashes.find(',');
+       if (comma == std::string::npos) {
+           fprintf(stderr, "--compare-hashes takes two logs: --compare-hashes=A,B\n");
+           return 1;
+       }
+       return StateHashLog::compare(options.compare_hashes.substr(0, comma), options.compare_hashes.substr(comma + 1), stdout) ? 0 : 1;
+   }
+
+   // Straight into the game, there is no one to dismiss the tutorial
+   globalOptions.tutorial = false;
+   globalOptions.pause = false;
+   globalOptions.cutscenes = false;
+
+   // Before the world is initialized, it restores the seed and tick rate of the recording
+   ReplayPlayer replay;
+   const bool replaying = !options.replay_path.empty();
+   if (replaying && !replay.open(options.replay_path)) {
+       return 1;
+   }
+   ReplayRecorder recorder;
+   if (!options.record_path.empty() && !recorder.open(options.record_path)) {
+       return 1;
+   }
+
+   NullAssetManager asset_manager;
+   NullRenderSystem renderer;
+   InputHandler input_handler;
+   initializeGameAssets(asset_manager);
+   renderer.setAssetManager(&asset_manager);
+   input_handler.setRenderer(&renderer);
+   input_handler.setRecorder(&recorder);
+
+   WorldSystem world(&renderer);
+   world.initialize();
+   printf("seed: %llu\n", (unsigned long long)rng_service.getSeed());
+
+   const float tick_ms = 1000.0f / globalOptions.tick_rate;
+   profiler.enabled = true;
+   profiler.reset();
+   FrameTimes tick_times;
+
+   auto last_report = std::chrono::high_resolution_clock::now();
+   long long tick = 0;
+   while (true) {
+       float elapsed_ms = tick_ms;
+       if (replaying) {
+           if (!replay.nextTick(input_handler, elapsed_ms)) break;
+       }
+       else if (tick >= options.ticks) {
+           break;
+       }
+       tick++;
+
+       if (registry.game_over) input_handler.reset();
+       const auto step_start = std::chrono::high_resolution_clock::now();
+       world.step(elapsed_ms);
+       tick_times.add(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - step_start).count());
+       recorder.tick(elapsed_ms);
+
+       if (options.report_every > 0 && tick % options.report_every == 0) {
+           const auto now = std::chrono::high_resolution_clock::now();
+           printf("-- tick %lld --\n", tick);
+           profiler.report(stdout, std::chrono::duration<double>(now - last_report).count());
+           profiler.reset();
+           last_report = now;
+       }
+   }
+
+   // Ticks since the last report, all of them without --report-every
+   if (options.report_every <= 0 || tick % options.report_every != 0) {
+       const auto end = std::chrono::high_resolution_clock::now();
+       if (options.report_every > 0) printf("-- tick %lld --\n", tick);
+       profiler.report(stdout, std::chrono::duration<double>(end - last_report).count());
+   }
+   if (replaying) {
+       printf("replay %s: %llu ticks\n", options.replay_path.c_str(), replay.getTicks());
+   }
+   tick_times.report(stdout, "tick time");
+   return 0;
+}
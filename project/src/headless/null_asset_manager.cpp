@@ -0,0 +1,63 @@
+#include "headless/null_asset_manager.hpp"
+
+AssetId NullAssetManager::loadMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<uint32_t>& indices, const std::vector<VertexAttribute>& attributes) {
+    auto mesh = std::make_shared<Mesh>();
+
+    size_t stride = 0;
+    for (const auto& attr : attributes) {
+        stride += attr.size;
+    }
+
+    mesh->vertexCount = stride > 0 ? vertices.size() / stride : 0;
+    mesh->indexCount = indices.size();
+    mesh->vertices = vertices;
+    mesh->indices = indices;
+    mesh->attributes = attributes;
+
+    meshes[name] = std::move(mesh);
+    return name;
+}
+
+AssetId NullAssetManager::loadParticleMesh(const std::string& name, const std::vector<float>& vertices, const std::vector<uint32_t>& indices) {
+    return loadMesh(name, vertices, indices, { {3, GL_FLOAT, GL_FALSE, "position"} });
+}
+
+AssetId NullAssetManager::loadTexture(const std::string& name, const std::string&) {
+    return name;
+}
+
+AssetId NullAssetManager::loadBackgroundTexture(const std::string& name, const std::string&) {
+    return name;
+}
+
+AssetId NullAssetManager::loadShader(const std::string& name, const std::string&, const std::string&) {
+    return name;
+}
+
+AssetId NullAssetManager::createMaterial(const std::string& name, const AssetId&, const AssetId&) {
+    return name;
+}
+
+AssetId NullAssetManager::loadFont(const std::string& name, const std::string&, float) {
+    return name;
+}
+
+Shader* NullAssetManager::getShader(const AssetId&) {
+    return nullptr;
+}
+
+Mesh* NullAssetManager::getMesh(const AssetId& name) {
+    const auto it = meshes.find(name);
+    if (it != meshes.end()) {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+Texture* NullAssetManager::getTexture(const AssetId&) {
+    return nullptr;
+}
+
+Font* NullAssetManager::getFont(const AssetId&) {
+    return nullptr;
+}
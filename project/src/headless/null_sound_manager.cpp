@@ -0,0 +1,56 @@
+// SoundManager of the headless build, linked instead of sound/sound_manager.cpp.
+// Nothing is loaded or played, only the music state the game reads back is kept.
+
+#include "sound/sound_manager.hpp"
+
+SoundManager* SoundManager::instance = nullptr;
+
+SoundManager::SoundManager() : musicPlaying(false), musicStopped(true) {}
+
+SoundManager* SoundManager::getSoundManager() {
+    if (instance == nullptr) {
+        instance = new SoundManager();
+    }
+    return instance;
+}
+
+bool SoundManager::initialize() {
+    return true;
+}
+
+void SoundManager::playSound(SoundEffect) {
+}
+
+void SoundManager::playMusic(Song, int) {
+    musicPlaying = true;
+    musicStopped = false;
+}
+
+void SoundManager::fadeInMusic(Song) {
+    musicPlaying = true;
+    musicStopped = false;
+}
+
+void SoundManager::toggleMusic() {
+    if (!musicStopped) {
+        musicPlaying = !musicPlaying;
+    }
+}
+
+void SoundManager::stopMusic() {
+    musicPlaying = false;
+    musicStopped = true;
+}
+
+bool SoundManager::isMusicPlaying() {
+    return musicPlaying;
+}
+
+void SoundManager::removeSoundManager() {
+}
+
+void SoundManager::registerSound(SoundEffect, const char*) {
+}
+
+void SoundManager::registerMusic(Song, const char*) {
+}
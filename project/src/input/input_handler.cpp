@@ -41,6 +41,8 @@ bool isPause()
 
 void InputHandler::onKey(int key, int scancode, int action, int mods)
 {
+    if (recorder) recorder->key(key, scancode, action, mods);
+
     SoundManager* soundManager = SoundManager::getSoundManager();
 
     if (action == GLFW_PRESS && key == GLFW_KEY_L && (globalOptions.pause || globalOptions.tutorial) && !globalOptions.loadingOldGame) {
@@ -187,6 +189,20 @@ void InputHandler::onKey(int key, int scancode, int action, int mods)
 
 void InputHandler::onMouseMove(vec2 mouse_position)
 {
+    float xNDC = (2.f * mouse_position.x) / window_width_px - 1.f;
+    float yNDC = 1.f - (2.f * mouse_position.y) / window_height_px;
+    mat4 inverseView = glm::inverse(registry.projectionMatrix * registry.viewMatrix);
+    vec4 world = inverseView * vec4(xNDC, yNDC, 0.f, 1.f);
+
+    // printd("MOUSE x: %f, y: %f \n", world.x, world.y);
+
+    onMouseMoveWorld(vec2(world.x, world.y));
+}
+
+void InputHandler::onMouseMoveWorld(vec2 world_position)
+{
+    if (recorder) recorder->mouseMove(world_position);
+
     if (isPlayerDead() || isTutorialOn())
     {
         return;
@@ -194,27 +210,18 @@ void InputHandler::onMouseMove(vec2 mouse_position)
     Entity& player = registry.players.entities[0];
     Motion& playerMotion = registry.motions.get(player);
 
-    // Entity& camera = registry.cameras.entities[0];
-    // Camera& cameraEntity = registry.cameras.get(camera);
+    this->worldMousePosition = world_position;
 
-    float xNDC = (2.f * mouse_position.x) / window_width_px - 1.f;
-    float yNDC = 1.f - (2.f * mouse_position.y) / window_height_px;
-    mat4 inverseView = glm::inverse(registry.projectionMatrix * registry.viewMatrix);
-    vec4 world = inverseView * vec4(xNDC, yNDC, 0.f, 1.f);
-
-    this->worldMousePosition = vec2(world.x, world.y);
-
-    float dx = world.x - playerMotion.position.x;
-    float dy = world.y - playerMotion.position.y;
-
-    // printd("CAMERA: %f, %f\n", cameraEntity.position.x, cameraEntity.position.y);
-    // printd("MOUSE x: %f, y: %f \n", world.x, world.y);
+    float dx = world_position.x - playerMotion.position.x;
+    float dy = world_position.y - playerMotion.position.y;
 
     playerMotion.angle = atan2(dy, dx);
 }
 
-void InputHandler::onMouseKey(GLFWwindow* window, int button, int action, int mods)
+void InputHandler::onMouseKey(int button, int action, int mods)
 {
+    if (recorder) recorder->mouseButton(button, action, mods);
+
     if (isTutorialOn() && !globalOptions.loadingOldGame) {
         // SoundManager* soundManager = SoundManager::getSoundManager();
         // if (!globalOptions.pause)
@@ -235,11 +242,6 @@ void InputHandler::onMouseKey(GLFWwindow* window, int button, int action, int mo
         return;
     }
 
-    // fixes issue where mouse position isn't set until mouse is moved
-    double x, y;
-    glfwGetCursorPos(window, &x, &y);
-    this->onMouseMove({ x, y });
-
     if (action == GLFW_PRESS)
     {
         switch (button)
@@ -354,3 +356,8 @@ void InputHandler::setRenderer(IRenderSystem* renderer)
 {
     this->renderer = renderer;
 }
+
+void InputHandler::setRecorder(ReplayRecorder* recorder)
+{
+    this->recorder = recorder;
+}
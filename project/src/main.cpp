@@ -8,21 +8,73 @@
 #include "core/render_system.hpp"
 #include "core/world_system.hpp"
 #include "input/input_handler.hpp"
+#include "input/null_input_handler.hpp"
 #include "utils/game_assets.hpp"
+#include "utils/command_line.hpp"
+#include "utils/rng.hpp"
+#include "utils/replay.hpp"
+#include "utils/profiler.hpp"
+#include "graphics/asset_manager.hpp"
 #include "sound/sound_manager.hpp"
 #include "core/common.hpp"
 #include "entities/general_components.hpp"
 
 #define ERROR_SUCCESS 0  // For Mac OS
 
+struct GameOptions {
+   std::string record_path; // write the session to this replay file
+   std::string replay_path; // play this replay file back instead of taking input
+};
+
+// Startup options, e.g. --broadphase=sap --tick-rate=30 --record=session.replay
+static void parseArguments(int argc, char* argv[], GameOptions& options)
+{
+   for (int i = 1; i < argc; i++) {
+       const std::string arg = argv[i];
+       const char* value = nullptr;
+       if ((value = argumentValue(arg, "--record"))) {
+           options.record_path = value;
+       }
+       else if ((value = argumentValue(arg, "--replay"))) {
+           options.replay_path = value;
+       }
+       else if (!parseSimulationArgument(arg)) {
+           fprintf(stderr, "Unknown argument: %s\n", arg.c_str());
+       }
+   }
+}
+
 int main(int argc, char* argv[])
 {
+   GameOptions options;
+   parseArguments(argc, argv, options);
+
+   // Before the world is initialized, it restores the seed and tick rate of the recording
+   ReplayPlayer replay;
+   const bool replaying = !options.replay_path.empty();
+   if (replaying && !replay.open(options.replay_path)) {
+       return 1;
+   }
+   ReplayRecorder recorder;
+   if (!options.record_path.empty() && !recorder.open(options.record_path)) {
+       return 1;
+   }
+   if (replaying || recorder.isOpen()) {
+       globalOptions.cutscenes = false;
+   }
+   printd("Random seed: %llu (replay with --seed)\n", (unsigned long long)rng_service.getSeed());
+
    auto asset_manager = std::make_unique<AssetManager>();
    auto renderer = std::make_unique<RenderSystem>();
    auto input_handler = std::make_unique<InputHandler>();
+   NullInputHandler ignored_input;
    
    WorldSystem world(renderer.get());
-   renderer->initialize(*input_handler, window_width_px, window_height_px, "Soulless");  // must be called at the beginning of the program  
+   // While replaying, the window's input is ignored and the recording drives the input handler
+   IInputHandler& window_input = replaying ? static_cast<IInputHandler&>(ignored_input) : *input_handler;
+   renderer->initialize(window_input, window_width_px, window_height_px, "Soulless");  // must be called at the beginning of the program  
+   input_handler->setRenderer(renderer.get());
+   input_handler->setRecorder(&recorder);
    GLFWwindow* window = renderer->getGLWindow();
    SoundManager* soundManager = SoundManager::getSoundManager();
    if (!soundManager->initialize()) {
@@ -37,6 +89,12 @@ int main(int argc, char* argv[])
    auto t = std::chrono::high_resolution_clock::now();
    unsigned int frames = 0;
    auto lastTime = std::chrono::high_resolution_clock::now();
+
+   // The simulation advances in fixed ticks, rendering interpolates between the last two
+   const float tick_ms = 1000.0f / globalOptions.tick_rate;
+   float accumulator_ms = 0.0f;
+   FrameTimes frame_times;
+   FrameTimes tick_times;
    
    while (!glfwWindowShouldClose(window)) { // Game loop* / IMPORTANT: The following lines order are CRUCIAL to the rendering process
        renderer->setUpView();  // (1) clear the screen*
@@ -45,13 +103,37 @@ int main(int argc, char* argv[])
        const float elapsed_ms = static_cast<float>((std::chrono::duration_cast<std::chrono::microseconds>(now - t)).count()) / 1000.0f;
        t = now;
        
-       if (!globalOptions.tutorial && !globalOptions.pause && !renderer->isPlayingVideo()){
-           if (registry.game_over) input_handler->reset();
-           world.step(elapsed_ms);  // (2) Update the game state
+       if (replaying) frame_times.add(elapsed_ms);
+       
+       // A replay keeps going through pauses, the recording only has the ticks that ran and the input that resumed them
+       if (replaying || (!globalOptions.tutorial && !globalOptions.pause && !renderer->isPlayingVideo())){
+           accumulator_ms += elapsed_ms;
+           int steps = 0;
+           while (accumulator_ms >= tick_ms && steps < globalOptions.max_steps_per_frame) {
+               float step_ms = tick_ms;
+               if (replaying && !replay.nextTick(*input_handler, step_ms)) {
+                   glfwSetWindowShouldClose(window, GLFW_TRUE);
+                   break;
+               }
+               if (registry.game_over) input_handler->reset();
+               const auto step_start = std::chrono::high_resolution_clock::now();
+               world.step(step_ms);  // (2) Update the game state
+               if (replaying) tick_times.add(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - step_start).count());
+               recorder.tick(step_ms);
+               accumulator_ms -= tick_ms;
+               steps++;
+               if (registry.game_over) break;
+           }
+           // After a hitch, drop the time that could not be simulated instead of catching up over the next frames
+           if (accumulator_ms >= tick_ms) accumulator_ms = std::fmod(accumulator_ms, tick_ms);
            if (registry.game_over) continue;
        }
+       else {
+           // Time spent paused is not simulated
+           accumulator_ms = 0.0f;
+       }
        
-       renderer->drawFrame(elapsed_ms);  // (3) Re-render the scene (where the magic happens)
+       renderer->drawFrame(elapsed_ms, accumulator_ms / tick_ms);  // (3) Re-render the scene (where the magic happens)
        
        frames++;
        auto currentTime = std::chrono::high_resolution_clock::now();
@@ -65,7 +147,6 @@ int main(int argc, char* argv[])
        
        glfwSwapBuffers(window);  // (4) swap front and back buffers
        glfwPollEvents();  // (5) poll for and process events
-       registry.debug_requests.clear();
 
        if (globalOptions.loadingOldGame) {
            world.reloadGame();
@@ -78,6 +159,13 @@ int main(int argc, char* argv[])
 
    }
    
+   if (replaying) {
+       printf("replay %s: %llu ticks\n", options.replay_path.c_str(), replay.getTicks());
+       frame_times.report(stdout, "frame time");
+       tick_times.report(stdout, "tick time");
+   }
+   recorder.close();
+
    // TODO: Add cleanup code here*
    soundManager->removeSoundManager();
    return ERROR_SUCCESS;
@@ -0,0 +1,22 @@
+#include "sound/sound_manager.hpp"
+
+// Kept apart from the SDL backed playback so the headless build can share it
+
+SoundEffect SoundManager::convertSpellToSoundEffect(SpellType spellType, int level) {
+    switch (spellType) {
+        case SpellType::FIRE:
+            return level == MAX_SPELL_LEVEL ? SoundEffect::FIRE_MAX : SoundEffect::FIRE;
+        case SpellType::WATER:
+            return SoundEffect::WATER;
+        case SpellType::LIGHTNING:
+            return SoundEffect::LIGHTNING;
+        case SpellType::ICE:
+            return level == MAX_SPELL_LEVEL ? SoundEffect::ICE_MAX : SoundEffect::ICE;
+        case SpellType::WIND:
+            return level == MAX_SPELL_LEVEL ? SoundEffect::WIND_MAX : SoundEffect::WIND;
+        case SpellType::PLASMA:
+            return SoundEffect::PLASMA;
+        default:
+            throw std::invalid_argument("Unknown SpellType");
+    }
+}
@@ -173,22 +173,3 @@ void SoundManager::registerMusic(Song song, const char* filePath) {
         music[song] = backgroundMusic;
     }
 }
-
-SoundEffect SoundManager::convertSpellToSoundEffect(SpellType spellType, int level) {
-    switch (spellType) {
-        case SpellType::FIRE:
-            return level == MAX_SPELL_LEVEL ? SoundEffect::FIRE_MAX : SoundEffect::FIRE;
-        case SpellType::WATER:
-            return SoundEffect::WATER;
-        case SpellType::LIGHTNING:
-            return SoundEffect::LIGHTNING;
-        case SpellType::ICE:
-            return level == MAX_SPELL_LEVEL ? SoundEffect::ICE_MAX : SoundEffect::ICE;
-        case SpellType::WIND:
-            return level == MAX_SPELL_LEVEL ? SoundEffect::WIND_MAX : SoundEffect::WIND;
-        case SpellType::PLASMA:
-            return SoundEffect::PLASMA;
-        default:
-            throw std::invalid_argument("Unknown SpellType");
-    }
-}
@@ -0,0 +1,46 @@
+#include "utils/collision_layers.hpp"
+
+void assignCollisionLayer(ECSRegistry& registry, Entity entity)
+{
+    uint32_t layer = 0;
+    uint32_t mask = 0;
+
+    if (registry.players.has(entity))
+    {
+        layer |= LAYER_PLAYER;
+        mask |= LAYER_ENEMY | LAYER_PROJECTILE | LAYER_INTERACTABLE;
+    }
+
+    // Based on roles rather than the current Deadly flags, which some enemies and spells toggle while alive
+    if (registry.enemies.has(entity))
+    {
+        layer |= LAYER_ENEMY;
+        mask |= LAYER_PLAYER;
+    }
+
+    // Projectile <-> projectile pairs are never resolved, so projectiles only look for their targets
+    if (registry.projectiles.has(entity))
+    {
+        layer |= LAYER_PROJECTILE;
+        const bool is_spell = registry.spellProjectiles.has(entity);
+        const Deadly* deadly = registry.deadlies.has(entity) ? &registry.deadlies.get(entity) : nullptr;
+        if (deadly && deadly->to_player) mask |= LAYER_PLAYER;
+        if (is_spell || (deadly && deadly->to_enemy)) mask |= LAYER_ENEMY;
+    }
+
+    if (registry.interactables.has(entity))
+    {
+        layer |= LAYER_INTERACTABLE;
+        mask |= LAYER_PLAYER;
+    }
+
+    if (layer == 0)
+    {
+        registry.collisionLayers.remove(entity);
+        return;
+    }
+
+    CollisionLayer& collision_layer = registry.collisionLayers.has(entity) ? registry.collisionLayers.get(entity) : registry.collisionLayers.emplace(entity);
+    collision_layer.layer = layer;
+    collision_layer.mask = mask;
+}
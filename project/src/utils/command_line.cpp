@@ -0,0 +1,39 @@
+#include "utils/command_line.hpp"
+#include "entities/general_components.hpp"
+#include "utils/rng.hpp"
+#include "utils/state_hash.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+const char* argumentValue(const std::string& arg, const std::string& name)
+{
+    const std::string prefix = name + "=";
+    return arg.compare(0, prefix.size(), prefix) == 0 ? arg.c_str() + prefix.size() : nullptr;
+}
+
+bool parseSimulationArgument(const std::string& arg)
+{
+    const char* value = nullptr;
+    if (arg == "--broadphase=sap") {
+        globalOptions.broadphase = BroadphaseType::SWEEP_AND_PRUNE;
+    }
+    else if (arg == "--broadphase=grid") {
+        globalOptions.broadphase = BroadphaseType::GRID;
+    }
+    else if ((value = argumentValue(arg, "--tick-rate"))) {
+        globalOptions.tick_rate = std::max(1, atoi(value));
+    }
+    else if ((value = argumentValue(arg, "--max-steps"))) {
+        globalOptions.max_steps_per_frame = std::max(1, atoi(value));
+    }
+    else if ((value = argumentValue(arg, "--seed"))) {
+        rng_service.seed(strtoull(value, nullptr, 10));
+    }
+    else if ((value = argumentValue(arg, "--hash-log"))) {
+        state_hash_log.open(value);
+    }
+    else {
+        return false;
+    }
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "utils/enemy_factory.hpp"
+#include "utils/collision_layers.hpp"
 
 namespace EnemyFactory {
 
@@ -18,7 +19,7 @@ namespace EnemyFactory {
         float healthScale,
         vec2 scale
     ) {
-        Entity enemy;
+        Entity enemy = Entity::create();
 
         Enemy& enemy_component = registry.enemies.emplace(enemy);
         enemy_component.type = type;
@@ -35,7 +36,7 @@ namespace EnemyFactory {
         health_component.health = health * healthScale;
         health_component.maxHealth = maxHealth * healthScale;
 
-        auto healthBar = Entity();
+        auto healthBar = Entity::create();
         HealthBar& healthBarComp = registry.healthBars.emplace(healthBar);
         healthBarComp.assignHealthBar(enemy);
         healthBarComp.position = { motion.position.x, motion.position.y - HEALTH_BAR_Y_OFFSET };
@@ -61,6 +62,7 @@ namespace EnemyFactory {
         request.type = ENEMY;
 
         AI_SYSTEM::initAIComponent(&enemy);
+        assignCollisionLayer(registry, enemy);
 
         return enemy;
     }
@@ -2,7 +2,7 @@
 
 #include "core/common.hpp"
 
-GameAssets initializeGameAssets(AssetManager& assetManager)
+GameAssets initializeGameAssets(IAssetManager& assetManager)
 {
     GameAssets assets;
     assets.shaders["basic"] = assetManager.loadShader("basic", shader_path("basic") + ".vs.glsl", shader_path("basic") + ".fs.glsl");
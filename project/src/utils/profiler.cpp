@@ -0,0 +1,65 @@
+#include "utils/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+Profiler profiler; // Simulation step timings, enabled by the headless runner
+
+void Profiler::reset()
+{
+    sections.clear();
+    ticks = 0;
+}
+
+void Profiler::record(const char* section, double elapsed_ms)
+{
+    for (Section& entry : sections)
+    {
+        if (entry.name == section || std::strcmp(entry.name, section) == 0)
+        {
+            entry.total_ms += elapsed_ms;
+            return;
+        }
+    }
+    sections.push_back({ section, elapsed_ms });
+}
+
+void Profiler::report(FILE* out, double wall_seconds) const
+{
+    const double ticks_per_second = wall_seconds > 0 ? ticks / wall_seconds : 0;
+    fprintf(out, "%llu ticks in %.2f s: %.1f ticks/sec\n", ticks, wall_seconds, ticks_per_second);
+    if (ticks == 0) return;
+
+    double total_ms = 0;
+    for (const Section& entry : sections) total_ms += entry.total_ms;
+
+    fprintf(out, "%-24s %12s %8s\n", "system", "ms/tick", "share");
+    for (const Section& entry : sections)
+    {
+        fprintf(out, "%-24s %12.4f %7.1f%%\n", entry.name, entry.total_ms / ticks, total_ms > 0 ? 100.0 * entry.total_ms / total_ms : 0.0);
+    }
+}
+
+void FrameTimes::report(FILE* out, const char* name) const
+{
+    if (samples.empty())
+    {
+        fprintf(out, "%s: no samples\n", name);
+        return;
+    }
+
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    double total_ms = 0;
+    for (double sample : sorted) total_ms += sample;
+
+    // Nearest rank
+    auto percentile = [&sorted](double p) {
+        const size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+        return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+    };
+
+    fprintf(out, "%s: %zu samples, mean %.3f ms, min %.3f, p50 %.3f, p95 %.3f, p99 %.3f, max %.3f\n",
+        name, sorted.size(), total_ms / sorted.size(), sorted.front(),
+        percentile(50), percentile(95), percentile(99), sorted.back());
+}
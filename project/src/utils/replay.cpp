@@ -0,0 +1,202 @@
+#include "utils/replay.hpp"
+#include "isystems/IInputHandler.hpp"
+#include "entities/general_components.hpp"
+#include "utils/rng.hpp"
+#include <cstring>
+
+static const char REPLAY_MAGIC[4] = { 'S', 'L', 'R', 'P' };
+static const uint32_t REPLAY_VERSION = 1;
+
+template <typename T>
+static void write(FILE* file, T value)
+{
+    fwrite(&value, sizeof(T), 1, file);
+}
+
+template <typename T>
+static bool read(FILE* file, T& value)
+{
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    close();
+}
+
+bool ReplayRecorder::open(const std::string& path)
+{
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot write replay %s\n", path.c_str());
+        return false;
+    }
+
+    fwrite(REPLAY_MAGIC, sizeof(REPLAY_MAGIC), 1, file);
+    write<uint32_t>(file, REPLAY_VERSION);
+    write<uint64_t>(file, rng_service.getSeed());
+    write<uint32_t>(file, (uint32_t)globalOptions.tick_rate);
+    write<uint8_t>(file, (uint8_t)globalOptions.broadphase);
+    write<uint8_t>(file, (uint8_t)globalOptions.tutorial);
+    return true;
+}
+
+void ReplayRecorder::close()
+{
+    if (!file) return;
+    flushTicks();
+    fclose(file);
+    file = nullptr;
+}
+
+void ReplayRecorder::key(int key, int scancode, int action, int mods)
+{
+    if (!file) return;
+    flushTicks();
+    write<uint8_t>(file, (uint8_t)ReplayRecord::KEY);
+    write<int16_t>(file, (int16_t)key);
+    write<int16_t>(file, (int16_t)scancode);
+    write<uint8_t>(file, (uint8_t)action);
+    write<uint8_t>(file, (uint8_t)mods);
+}
+
+void ReplayRecorder::mouseMove(vec2 world_position)
+{
+    if (!file) return;
+    flushTicks();
+    write<uint8_t>(file, (uint8_t)ReplayRecord::MOUSE_MOVE);
+    write<float>(file, world_position.x);
+    write<float>(file, world_position.y);
+}
+
+void ReplayRecorder::mouseButton(int button, int action, int mods)
+{
+    if (!file) return;
+    flushTicks();
+    write<uint8_t>(file, (uint8_t)ReplayRecord::MOUSE_BUTTON);
+    write<uint8_t>(file, (uint8_t)button);
+    write<uint8_t>(file, (uint8_t)action);
+    write<uint8_t>(file, (uint8_t)mods);
+}
+
+void ReplayRecorder::tick(float elapsed_ms)
+{
+    if (!file) return;
+    if (pending_ticks > 0 && elapsed_ms != pending_elapsed_ms) flushTicks();
+    pending_elapsed_ms = elapsed_ms;
+    pending_ticks++;
+}
+
+void ReplayRecorder::flushTicks()
+{
+    if (pending_ticks == 0) return;
+    write<uint8_t>(file, (uint8_t)ReplayRecord::TICKS);
+    write<uint32_t>(file, pending_ticks);
+    write<float>(file, pending_elapsed_ms);
+    pending_ticks = 0;
+}
+
+ReplayPlayer::~ReplayPlayer()
+{
+    close();
+}
+
+bool ReplayPlayer::open(const std::string& path)
+{
+    close();
+    file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot read replay %s\n", path.c_str());
+        return false;
+    }
+
+    char magic[sizeof(REPLAY_MAGIC)];
+    uint32_t version = 0;
+    uint64_t seed = 0;
+    uint32_t tick_rate = 0;
+    uint8_t broadphase = 0;
+    uint8_t tutorial = 0;
+    if (fread(magic, sizeof(magic), 1, file) != 1 || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0
+        || !read(file, version) || version != REPLAY_VERSION
+        || !read(file, seed) || !read(file, tick_rate) || tick_rate == 0 || !read(file, broadphase) || !read(file, tutorial))
+    {
+        fprintf(stderr, "%s is not a replay of this version\n", path.c_str());
+        close();
+        return false;
+    }
+
+    rng_service.seed(seed);
+    globalOptions.tick_rate = (int)tick_rate;
+    globalOptions.broadphase = (BroadphaseType)broadphase;
+    globalOptions.tutorial = tutorial != 0;
+    globalOptions.pause = false;
+    return true;
+}
+
+void ReplayPlayer::close()
+{
+    if (!file) return;
+    fclose(file);
+    file = nullptr;
+    pending_ticks = 0;
+}
+
+bool ReplayPlayer::nextTick(IInputHandler& input, float& elapsed_ms)
+{
+    while (file && pending_ticks == 0)
+    {
+        uint8_t type;
+        if (!read(file, type)) break;
+
+        bool complete = false;
+        switch ((ReplayRecord)type)
+        {
+        case ReplayRecord::TICKS:
+            complete = read(file, pending_ticks) && read(file, pending_elapsed_ms);
+            break;
+        case ReplayRecord::KEY:
+        {
+            int16_t key, scancode;
+            uint8_t action, mods;
+            complete = read(file, key) && read(file, scancode) && read(file, action) && read(file, mods);
+            if (complete) input.onKey(key, scancode, action, mods);
+            break;
+        }
+        case ReplayRecord::MOUSE_MOVE:
+        {
+            vec2 position;
+            complete = read(file, position.x) && read(file, position.y);
+            if (complete) input.onMouseMoveWorld(position);
+            break;
+        }
+        case ReplayRecord::MOUSE_BUTTON:
+        {
+            uint8_t button, action, mods;
+            complete = read(file, button) && read(file, action) && read(file, mods);
+            if (complete) input.onMouseKey(button, action, mods);
+            break;
+        }
+        }
+
+        if (!complete)
+        {
+            fprintf(stderr, "Replay ends with a broken record after %llu ticks\n", ticks);
+            pending_ticks = 0;
+            break;
+        }
+    }
+
+    if (pending_ticks == 0)
+    {
+        close();
+        return false;
+    }
+
+    pending_ticks--;
+    ticks++;
+    elapsed_ms = pending_elapsed_ms;
+    return true;
+}
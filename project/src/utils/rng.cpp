@@ -0,0 +1,61 @@
+#include "utils/rng.hpp"
+#include <random>
+
+RngService rng_service; // Random numbers of every system, see --seed
+
+void Pcg32::seed(uint64_t state_seed, uint64_t stream)
+{
+    state = 0;
+    increment = (stream << 1) | 1;
+    (*this)();
+    state += state_seed;
+    (*this)();
+}
+
+Pcg32::result_type Pcg32::operator()()
+{
+    const uint64_t old_state = state;
+    state = old_state * 6364136223846793005ULL + increment;
+    const uint32_t xorshifted = (uint32_t)(((old_state >> 18) ^ old_state) >> 27);
+    const uint32_t rotation = (uint32_t)(old_state >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((0u - rotation) & 31));
+}
+
+float Pcg32::uniform(float min, float max)
+{
+    // Top 24 bits, exactly representable as a float in [0, 1)
+    const float unit = ((*this)() >> 8) * (1.f / 16777216.f);
+    return min + (max - min) * unit;
+}
+
+int Pcg32::uniformInt(int min, int max)
+{
+    const uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+    return (int)(min + (int64_t)(((uint64_t)(*this)() * range) >> 32));
+}
+
+// splitmix64, spreads consecutive seeds over the whole state space
+static uint64_t next_seed(uint64_t& x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+RngService::RngService()
+{
+    std::random_device device;
+    seed(((uint64_t)device() << 32) | device());
+}
+
+void RngService::seed(uint64_t master_seed)
+{
+    this->master_seed = master_seed;
+
+    uint64_t sequence = master_seed;
+    for (int i = 0; i < (int)RngStream::COUNT; i++)
+    {
+        streams[i].seed(next_seed(sequence), (uint64_t)i);
+    }
+}
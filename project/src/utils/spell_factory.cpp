@@ -1,5 +1,7 @@
 #include "utils/spell_factory.hpp"
+#include "utils/collision_layers.hpp"
 #include "sound/sound_manager.hpp"
+#include "utils/rng.hpp"
 
 namespace SpellFactory {
 
@@ -123,7 +125,7 @@ namespace SpellFactory {
   }
 
   Entity initSpellEntity(ECSRegistry& registry, vec2 position, float angle, vec2 velocity, int level) {
-    const Entity ent;
+    const Entity ent = Entity::create();
 
     registry.projectiles.emplace(ent);
     SpellProjectile& spell = registry.spellProjectiles.emplace(ent);
@@ -141,6 +143,8 @@ namespace SpellFactory {
     request.mesh = "sprite";
     request.shader = "sprite";
 
+    assignCollisionLayer(registry, ent);
+
     return ent;
   }
 
@@ -159,6 +163,7 @@ namespace SpellFactory {
     spell.level = level;
 
     deadly.to_enemy = true;
+    registry.sweptColliders.emplace(spell_ent).start_position = spell_motion.position;
 
     request.type = PROJECTILE;
 
@@ -192,7 +197,7 @@ namespace SpellFactory {
   void configureWaterSpell(ECSRegistry& registry, Entity& spell_ent, int level) {
 
     // reset player's onHits
-    registry.onHits.remove(registry.players.entities[0]);
+    registry.commands.remove(registry.onHits, registry.players.entities[0]);
 
     Motion& spell_motion = registry.motions.get(spell_ent);
     Projectile& projectile = registry.projectiles.get(spell_ent);
@@ -251,11 +256,8 @@ namespace SpellFactory {
 
     if (is_chain)
     {
-      std::random_device rand;
-      std::mt19937 gen(rand());
-
-      std::uniform_real_distribution<float> time_mod(MAX_LIGHTNING_DELAY_DIFFERENCE.x, MAX_LIGHTNING_DELAY_DIFFERENCE.y);
-      spellState.timer = LIGHTNING_CASTING_LIFETIME + time_mod(gen);
+      Pcg32& rng = rng_service.stream(RngStream::SPELLS);
+      spellState.timer = LIGHTNING_CASTING_LIFETIME + rng.uniform(MAX_LIGHTNING_DELAY_DIFFERENCE.x, MAX_LIGHTNING_DELAY_DIFFERENCE.y);
       damage.value = MAX_LIGHTNING_DAMAGE;
       spellState.isChild = true;
       spell.level = MAX_SPELL_LEVEL;
@@ -336,6 +338,7 @@ namespace SpellFactory {
     {
       spell_motion.collider = MAX_ICE_COLLIDER;
       spell_motion.scale = MAX_ICE_SCALE;
+      registry.sweptColliders.emplace(spell_ent).start_position = spell_motion.position;
       projectile.range = MAX_ICE_RANGE;
       damage.value = MAX_ICE_DAMAGE;
     }
@@ -362,6 +365,7 @@ namespace SpellFactory {
     spell.type = SpellType::PLASMA;
 
     deadly.to_enemy = true;
+    registry.sweptColliders.emplace(spell_ent).start_position = spell_motion.position;
 
     damage.value = PLASMA_DAMAGE;
     damage.type = DamageType::plasma;
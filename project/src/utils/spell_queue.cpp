@@ -1,15 +1,11 @@
-#include <random>
 #include <deque>
 #include <unordered_map>
 #include "utils/constants.hpp"
 #include "utils/spell_queue.hpp"
+#include "utils/rng.hpp"
 
 
 SpellQueue::SpellQueue() {
-  // init random number generator
-  std::random_device rd;
-  rng = std::mt19937(rd());
-
   // init have collected zero spells
   for (int i = 0; i < static_cast<int>(SpellType::COUNT); i++) {
     SpellType spell = static_cast<SpellType>(i);
@@ -140,7 +136,7 @@ void SpellQueue::addSpell() {
  * @return Random type of spell from the collected spells
  */
 SpellType SpellQueue::getRandomSpell() {
-  // create discrete distribution for random spell selection
+  // weighted random spell selection
   std::vector<SpellType> spells;
   std::vector<int> weights;
   for (const auto& pair : collectedSpells) {
@@ -149,11 +145,20 @@ SpellType SpellQueue::getRandomSpell() {
     // printf("Spell: %d, Weight: %d\n", pair.first, pair.second);
   }
 
-  std::discrete_distribution<> dist(weights.begin(), weights.end());
+  int total_weight = 0;
+  for (int weight : weights) {
+    total_weight += weight;
+  }
 
-  // generate random spell index, return which spell is selected
-  int index = dist(rng);
-  return spells[index];
+  // pick a point in the summed weights, return the spell whose weight covers it
+  int pick = rng_service.stream(RngStream::SPELL_QUEUE).uniformInt(0, total_weight - 1);
+  for (size_t i = 0; i < spells.size(); i++) {
+    if (pick < weights[i]) {
+      return spells[i];
+    }
+    pick -= weights[i];
+  }
+  return spells.back();
 }
 
 /**
@@ -205,19 +210,17 @@ bool SpellQueue::isAbleToSacrifice()
 
 void SpellQueue::doPlasmaSacrifice()
 {
-  std::random_device rd;
-
-  std::uniform_int_distribution<int> spell_choice(0, (static_cast<int>(SpellType::COUNT) - 1 - NOT_DROPPED_SPELL_COUNT));
-  std::mt19937 gen(rd());
+  Pcg32& rng = rng_service.stream(RngStream::SPELL_QUEUE);
+  const int last_dropped_spell = static_cast<int>(SpellType::COUNT) - 1 - NOT_DROPPED_SPELL_COUNT;
 
   if (!isAbleToSacrifice()) return;
 
   for (int x = 0; x < PLASMA_SACRIFICE_COST; x++)
   {
-    SpellType choice = static_cast<SpellType>(spell_choice(gen));
+    SpellType choice = static_cast<SpellType>(rng.uniformInt(0, last_dropped_spell));
     while (collectedSpells[choice] <= 1)
     {
-      choice = static_cast<SpellType>(spell_choice(gen));
+      choice = static_cast<SpellType>(rng.uniformInt(0, last_dropped_spell));
     }
     collectedSpells[choice]--;
   }
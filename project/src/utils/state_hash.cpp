@@ -0,0 +1,248 @@
+#include "utils/state_hash.hpp"
+#include "entities/ecs_registry.hpp"
+#include "entities/general_components.hpp"
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+
+StateHashLog state_hash_log; // Per-tick state hashes, see --hash-log
+
+static const char* const COMPONENT_NAMES[(int)HashedComponent::COUNT] = {
+    "motion", "health", "enemy", "projectile", "spell_state", "spell_queue"
+};
+
+const char* hashedComponentName(HashedComponent component)
+{
+    return COMPONENT_NAMES[(int)component];
+}
+
+// splitmix64 finalizer
+static uint64_t mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Order dependent hash of one entity's fields
+class FieldHasher
+{
+public:
+    FieldHasher& add(uint64_t value)
+    {
+        hash = (hash ^ value) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+        return *this;
+    }
+
+    FieldHasher& add(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return add((uint64_t)bits);
+    }
+
+    FieldHasher& add(vec2 value) { return add(value.x).add(value.y); }
+    FieldHasher& add(bool value) { return add((uint64_t)value); }
+    FieldHasher& add(int value) { return add((uint64_t)(int64_t)value); }
+
+    template <typename Enum>
+    FieldHasher& addEnum(Enum value) { return add((uint64_t)(int64_t)value); }
+
+    uint64_t finish() const { return mix(hash); }
+
+private:
+    uint64_t hash = 0x6A09E667F3BCC908ULL;
+};
+
+// Sum of the hashes of every component in the container, combined with their count
+template <typename Component, typename HashFields>
+static uint64_t hashContainer(const ComponentContainer<Component>& container, HashFields&& hash_fields)
+{
+    uint64_t sum = 0;
+    for (const Component& component : container.components)
+    {
+        FieldHasher hasher;
+        hash_fields(hasher, component);
+        sum += hasher.finish();
+    }
+    return mix(sum ^ mix(container.components.size()));
+}
+
+// Entries of zero are the same as missing ones, getSpellLevel() adds them on lookup
+static uint64_t hashSpellMap(const std::unordered_map<SpellType, int, SpellTypeHash>& map)
+{
+    uint64_t sum = 0;
+    for (const auto& entry : map)
+    {
+        if (entry.second == 0) continue;
+        sum += FieldHasher().addEnum(entry.first).add(entry.second).finish();
+    }
+    return sum;
+}
+
+bool StateHash::operator==(const StateHash& other) const
+{
+    return total == other.total && std::memcmp(components, other.components, sizeof(components)) == 0;
+}
+
+StateHash computeStateHash()
+{
+    StateHash state;
+    uint64_t* components = state.components;
+
+    components[(int)HashedComponent::MOTION] = hashContainer(registry.motions, [](FieldHasher& h, const Motion& motion) {
+        h.add(motion.position).add(motion.velocity).add(motion.scale).add(motion.collider)
+            .add(motion.mass).add(motion.speedModifier).add(motion.angle)
+            .addEnum(motion.currentDirection).addEnum(motion.oldDirection);
+    });
+
+    components[(int)HashedComponent::HEALTH] = hashContainer(registry.healths, [](FieldHasher& h, const Health& health) {
+        h.add(health.health).add(health.maxHealth);
+    });
+
+    components[(int)HashedComponent::ENEMY] = hashContainer(registry.enemies, [](FieldHasher& h, const Enemy& enemy) {
+        h.addEnum(enemy.type).add(enemy.range).add(enemy.cooldown).add(enemy.secondCooldown).add(enemy.eTimer)
+            .add(enemy.blocking).add(enemy.altAttackPattern).add(enemy.normalBehaviour).add(enemy.movementRestricted);
+    });
+
+    components[(int)HashedComponent::PROJECTILE] = hashContainer(registry.projectiles, [](FieldHasher& h, const Projectile& projectile) {
+        h.addEnum(projectile.type).add(projectile.range).add(projectile.sourcePosition).add(projectile.isActive);
+    });
+
+    // The entities a spell has seen are only counted, their ids differ between runs that create other entities
+    components[(int)HashedComponent::SPELL_STATE] = hashContainer(registry.spellStates, [](FieldHasher& h, const SpellState& spell_state) {
+        h.addEnum(spell_state.state).add(spell_state.timer).add(spell_state.isChild)
+            .add(spell_state.isBarrier).add(spell_state.barrier_level).add((uint64_t)spell_state.seen.size());
+    });
+
+    components[(int)HashedComponent::SPELL_QUEUE] = hashContainer(registry.players, [](FieldHasher& h, const Player& player) {
+        const SpellQueue& spell_queue = player.spell_queue;
+        h.addEnum(spell_queue.getLeftSpell()).addEnum(spell_queue.getRightSpell());
+        for (SpellType spell : spell_queue.getQueue()) h.addEnum(spell);
+        h.add((uint64_t)spell_queue.getQueue().size())
+            .add(hashSpellMap(spell_queue.getSpellLevels()))
+            .add(hashSpellMap(spell_queue.getUpgradeTracks()));
+    });
+
+    FieldHasher total;
+    for (uint64_t component : state.components) total.add(component);
+    state.total = total.finish();
+    return state;
+}
+
+StateHashLog::~StateHashLog()
+{
+    close();
+}
+
+bool StateHashLog::open(const std::string& path)
+{
+    close();
+    file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+        fprintf(stderr, "Cannot write state hash log %s\n", path.c_str());
+        return false;
+    }
+
+    fprintf(file, "# tick total");
+    for (const char* name : COMPONENT_NAMES) fprintf(file, " %s", name);
+    fprintf(file, "\n");
+    ticks = 0;
+    return true;
+}
+
+void StateHashLog::close()
+{
+    if (!file) return;
+    fclose(file);
+    file = nullptr;
+}
+
+void StateHashLog::record()
+{
+    if (!file) return;
+    const StateHash state = computeStateHash();
+
+    fprintf(file, "%llu %016" PRIx64, ++ticks, state.total);
+    for (uint64_t component : state.components) fprintf(file, " %016" PRIx64, component);
+    fprintf(file, "\n");
+}
+
+// Next tick of a log, false at its end
+static bool readLogLine(FILE* file, unsigned long long& tick, StateHash& state)
+{
+    char line[512];
+    while (fgets(line, sizeof(line), file))
+    {
+        if (line[0] == '#') continue;
+
+        const char* cursor = line;
+        char* end = nullptr;
+        tick = strtoull(cursor, &end, 10);
+        if (end == cursor) return false;
+
+        cursor = end;
+        state.total = strtoull(cursor, &end, 16);
+        for (uint64_t& component : state.components)
+        {
+            cursor = end;
+            component = strtoull(cursor, &end, 16);
+        }
+        return end != cursor;
+    }
+    return false;
+}
+
+bool StateHashLog::compare(const std::string& path_a, const std::string& path_b, FILE* out)
+{
+    FILE* file_a = fopen(path_a.c_str(), "r");
+    FILE* file_b = fopen(path_b.c_str(), "r");
+    if (!file_a || !file_b)
+    {
+        fprintf(stderr, "Cannot read state hash log %s\n", (!file_a ? path_a : path_b).c_str());
+        if (file_a) fclose(file_a);
+        if (file_b) fclose(file_b);
+        return false;
+    }
+
+    unsigned long long tick_a = 0, tick_b = 0, compared = 0;
+    StateHash state_a, state_b;
+    bool match = true;
+    bool more_a = false, more_b = false;
+    while (true)
+    {
+        more_a = readLogLine(file_a, tick_a, state_a);
+        more_b = readLogLine(file_b, tick_b, state_b);
+        if (!more_a || !more_b) break;
+
+        if (tick_a == tick_b && state_a == state_b)
+        {
+            compared++;
+            continue;
+        }
+
+        match = false;
+        fprintf(out, "First difference at tick %llu", tick_a);
+        if (tick_a != tick_b) fprintf(out, " (tick %llu in %s)", tick_b, path_b.c_str());
+        fprintf(out, "\n%-12s %-16s %-16s\n", "component", path_a.c_str(), path_b.c_str());
+        for (int i = 0; i < (int)HashedComponent::COUNT; i++)
+        {
+            fprintf(out, "%-12s %016" PRIx64 " %016" PRIx64 "%s\n", COMPONENT_NAMES[i],
+                state_a.components[i], state_b.components[i], state_a.components[i] != state_b.components[i] ? "  differs" : "");
+        }
+        break;
+    }
+
+    if (match)
+    {
+        fprintf(out, "%llu ticks match", compared);
+        if (more_a != more_b) fprintf(out, ", %s has more", (more_a ? path_a : path_b).c_str());
+        fprintf(out, "\n");
+    }
+
+    fclose(file_a);
+    fclose(file_b);
+    return match;
+}
@@ -0,0 +1,89 @@
+#include "utils/thread_pool.hpp"
+#include <algorithm>
+
+unsigned int ThreadPool::default_worker_count()
+{
+    const unsigned int hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads > 1 ? hardware_threads - 1 : 0;
+}
+
+ThreadPool::ThreadPool(unsigned int worker_count)
+{
+    for (unsigned int i = 0; i < worker_count; i++)
+    {
+        workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::run_chunks()
+{
+    for (;;)
+    {
+        const size_t begin = next_chunk.fetch_add(task_grain);
+        if (begin >= task_count) return;
+        (*task)(begin, std::min(begin + task_grain, task_count));
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& job)
+{
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || count <= grain)
+    {
+        if (count > 0) job(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &job;
+        task_count = count;
+        task_grain = grain;
+        next_chunk = 0;
+        busy_workers = (unsigned int)workers.size();
+        job_id++;
+    }
+    work_ready.notify_all();
+
+    run_chunks();
+
+    // The job lives on the caller's stack, every worker has to be done with it
+    std::unique_lock<std::mutex> lock(mutex);
+    work_done.wait(lock, [this] { return busy_workers == 0; });
+    task = nullptr;
+}
+
+void ThreadPool::worker_loop()
+{
+    unsigned int last_job = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [this, last_job] { return stopping || job_id != last_job; });
+            if (stopping) return;
+            last_job = job_id;
+        }
+
+        run_chunks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy_workers--;
+        }
+        work_done.notify_one();
+    }
+}
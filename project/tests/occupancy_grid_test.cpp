@@ -0,0 +1,116 @@
+// Checks the terrain occupancy grid on the isometric tile lattice the world bakes it on:
+// cells line up with the tiles, movement stops at and slides along blocked cells, and AI steering turns away from them.
+#include "core/occupancy_grid.hpp"
+#include "utils/isometric_helper.hpp"
+#include <cmath>
+#include <cstdio>
+#include <glm/geometric.hpp>
+
+static int failures = 0;
+
+static void check(bool condition, const char* what)
+{
+    if (condition) return;
+    fprintf(stderr, "FAILED: %s\n", what);
+    failures++;
+}
+
+// Same lattice as TileGenerator::bakeOccupancy, with tile (0, 0) centred on the world origin
+static void resetLikeTiles(OccupancyGrid& grid, int cols, int rows)
+{
+    const vec2 origin = IsometricGrid::getIsometricPosition(0, 0, true);
+    grid.reset(origin,
+               IsometricGrid::getIsometricPosition(1, 0, true) - origin,
+               IsometricGrid::getIsometricPosition(0, 1, true) - origin,
+               cols, rows);
+}
+
+static void testCellsMatchTiles()
+{
+    OccupancyGrid grid;
+    resetLikeTiles(grid, 40, 40);
+
+    for (int row = 1; row < 39; row += 7)
+    {
+        for (int col = 1; col < 39; col += 5)
+        {
+            grid.setBlocked(col, row);
+            const vec2 centre = IsometricGrid::getIsometricPosition(col, row, true);
+            check(grid.isBlocked(centre), "a tile centre is in its own cell");
+            check(!grid.isBlocked(IsometricGrid::getIsometricPosition(col + 1, row, true)), "the next tile in the row is free");
+            check(!grid.isBlocked(IsometricGrid::getIsometricPosition(col, row + 1, true)), "the next tile in the column is free");
+            grid.setBlocked(col, row, false);
+        }
+    }
+    check(grid.empty(), "clearing every blocked cell empties the grid");
+}
+
+static void testMovementStopsAtWall()
+{
+    OccupancyGrid grid;
+    resetLikeTiles(grid, 60, 40);
+    const int wall_row = 10;
+    for (int col = 0; col < 60; col++) grid.setBlocked(col, wall_row);
+
+    // Rows of the lattice are horizontal bands, this one starts here
+    const float wall_top = IsometricGrid::getIsometricPosition(0, wall_row, true).y - IsometricGrid::ISO_TILE_HEIGHT / 4.f;
+    const vec2 half_extents = { 8.f, 8.f };
+    const vec2 start = { 400.f, 50.f };
+
+    const vec2 stopped = grid.resolveMovement(start, { 400.f, 300.f }, half_extents);
+    check(stopped.y + half_extents.y <= wall_top, "a mover does not enter the wall");
+    check(stopped.y + half_extents.y > wall_top - IsometricGrid::ISO_TILE_HEIGHT / 2.f, "a mover stops within half a cell of the wall");
+    check(!grid.isBoxBlocked(stopped - half_extents, stopped + half_extents), "the resolved box is clear");
+
+    const vec2 tunnelled = grid.resolveMovement(start, { 400.f, 2000.f }, half_extents);
+    check(tunnelled.y < wall_top, "a long move does not tunnel through the wall");
+
+    const vec2 slid = grid.resolveMovement(start, { 500.f, 300.f }, half_extents);
+    check(std::abs(slid.x - 500.f) < 0.01f, "a mover slides along the wall");
+    check(slid.y + half_extents.y <= wall_top, "sliding stays out of the wall");
+
+    const vec2 away = grid.resolveMovement(start, { 400.f, 20.f }, half_extents);
+    check(away == vec2(400.f, 20.f), "moving away from the wall is free");
+
+    OccupancyGrid empty;
+    resetLikeTiles(empty, 60, 40);
+    check(empty.resolveMovement(start, { 400.f, 2000.f }, half_extents) == vec2(400.f, 2000.f), "an empty grid does not change movement");
+}
+
+static void testSteeringAvoidsWall()
+{
+    OccupancyGrid grid;
+    resetLikeTiles(grid, 60, 40);
+    for (int row = 8; row <= 12; row++)
+    {
+        for (int col = 0; col < 30; col++) grid.setBlocked(col, row);
+    }
+
+    const float lookahead = 60.f;
+    const vec2 position = { 200.f, 60.f };
+    const vec2 down = { 0.f, 1.f };
+    check(!grid.isSegmentClear(position, position + down * lookahead), "the wall is in the way");
+
+    const vec2 steered = grid.steerAround(position, down, lookahead);
+    check(steered != down, "steering turns away from the wall");
+    check(grid.isSegmentClear(position, position + steered * lookahead), "the steered direction is clear");
+    check(glm::dot(steered, down) > 0.f, "steering keeps heading the wanted way when it can");
+
+    const vec2 up = { 0.f, -1.f };
+    check(grid.steerAround(position, up, lookahead) == up, "a clear direction is kept");
+}
+
+int main()
+{
+    testCellsMatchTiles();
+    testMovementStopsAtWall();
+    testSteeringAvoidsWall();
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%d occupancy grid checks failed\n", failures);
+        return 1;
+    }
+    printf("occupancy grid checks passed\n");
+    return 0;
+}